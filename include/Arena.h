@@ -0,0 +1,57 @@
+#pragma once
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include "Constants.h"
+
+// Dimensions of the playfield in world units. By default the arena matches the
+// window; a larger arena is viewed through the Camera. Paddles sit at the left and
+// right edges and the gravity well at the center, wherever those end up.
+struct Arena {
+    // Largest side the 16.16 fixed-point path can hold: every coordinate, including the
+    // 50 units a ball travels past a goal line before it is removed, stays below 32768
+    static constexpr int MAX_FIXED_POINT_SIZE = 32000;
+    // Largest side in floating point; keeps the per-frame ball grid to a few million cells
+    static constexpr int MAX_SIZE = 100000;
+    static constexpr int MIN_WIDTH = Constants::WINDOW_WIDTH / 2;
+    static constexpr int MIN_HEIGHT = Constants::WINDOW_HEIGHT / 2;
+
+    int width = Constants::WINDOW_WIDTH;
+    int height = Constants::WINDOW_HEIGHT;
+
+    double centerX() const { return width / 2.0; }
+    double centerY() const { return height / 2.0; }
+
+    int leftPaddleX() const { return Constants::LEFT_PADDLE_START_X; }
+    int rightPaddleX() const { return width - 20 - Constants::PADDLE_WIDTH; }
+    int paddleStartY() const { return height / 2 - Constants::PADDLE_HEIGHT / 2; }
+
+    bool fitsFixedPoint() const { return width <= MAX_FIXED_POINT_SIZE && height <= MAX_FIXED_POINT_SIZE; }
+    // Reads "<width>x<height>" with nothing before, between or after the two numbers.
+    // Leaves the arena untouched and returns false when the text is malformed or out of range.
+    bool parse(const std::string& text) {
+        const char* cursor = text.c_str();
+        long parsedWidth = 0, parsedHeight = 0;
+        if (!parseSide(cursor, parsedWidth) || *cursor++ != 'x' || !parseSide(cursor, parsedHeight) || *cursor) {
+            return false;
+        }
+        if (parsedWidth < MIN_WIDTH || parsedHeight < MIN_HEIGHT || parsedWidth > MAX_SIZE || parsedHeight > MAX_SIZE) {
+            return false;
+        }
+        width = static_cast<int>(parsedWidth);
+        height = static_cast<int>(parsedHeight);
+        return true;
+    }
+
+    bool fitsWindow() const { return width <= Constants::WINDOW_WIDTH && height <= Constants::WINDOW_HEIGHT; }
+
+private:
+    static bool parseSide(const char*& cursor, long& side) {
+        // strtol would also take leading blanks and a sign
+        if (!std::isdigit(static_cast<unsigned char>(*cursor))) return false;
+        char* end;
+        side = std::strtol(cursor, &end, 10);
+        cursor = end;
+        return true;
+    }
+};
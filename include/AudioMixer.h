@@ -0,0 +1,59 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "SpscRing.h"
+
+enum class SoundEffect : uint8_t {
+    PADDLE_HIT,
+    WALL_BOUNCE,
+    POWERUP,
+    SCORE,
+    COUNT
+};
+
+// Mixes short sound effects inside SDL's audio stream callback. Effects are
+// synthesized into PCM buffers once at startup. The game thread requests playback
+// through a lock-free command queue, so it never takes the audio device lock, and
+// the callback mixes into a preallocated buffer without allocating.
+class AudioMixer {
+public:
+    static constexpr int SAMPLE_RATE = 48000;
+    static constexpr int CHANNELS = 2;
+    static constexpr int MAX_VOICES = 16;
+    static constexpr int MIX_CHUNK_FRAMES = 1024;
+
+    AudioMixer();
+    ~AudioMixer();
+
+    bool initialize();
+    void shutdown();
+
+    // Game thread. pan runs from -1 (left) to 1 (right).
+    void play(SoundEffect effect, float volume = 1.0f, float pan = 0.0f);
+
+private:
+    struct PlayCommand {
+        SoundEffect effect;
+        float volume;
+        float pan;
+    };
+
+    struct Voice {
+        const float* samples; // nullptr when the voice is free
+        int length;
+        int position;
+        float gainLeft, gainRight;
+    };
+
+    SDL_AudioStream* stream;
+    SpscRing<PlayCommand, 64> commands;
+    std::vector<float> sounds[static_cast<int>(SoundEffect::COUNT)]; // Mono PCM at SAMPLE_RATE
+    Voice voices[MAX_VOICES];
+    std::vector<float> mixBuffer; // Interleaved stereo, MIX_CHUNK_FRAMES long
+
+    static void SDLCALL audioCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount);
+    void mix(SDL_AudioStream* stream, int bytesNeeded);
+    void startVoice(const PlayCommand& command);
+    void synthesizeSounds();
+};
@@ -1,9 +1,13 @@
 #pragma once
 #include <SDL3/SDL.h>
-#include <random>
 #include "Vector2.h"
 #include "Constants.h"
 #include "Paddle.h"
+#include "Random.h"
+#include "Arena.h"
+#include "FixedPoint.h"
+
+class Camera;
 
 class Ball {
 public:
@@ -11,11 +15,25 @@ public:
     Vector2 velocity;
     int width, height;
     
+    // Event-driven flight: the first tick at which Match integrates and tests this ball
+    // again. Until then it flies a straight line with nothing in reach. 0 for new balls.
+    uint32_t coastUntil;
+    
     Ball(int x, int y, int size);
     
-    void move();
-    void draw(SDL_Renderer* renderer) const;
-    void serve();
+    // Advance by dt ticks of the 60 Hz reference rate. Without gravity the flight is a
+    // straight line and the well is never evaluated
+    template<bool Gravity = true>
+    void move(const Arena& arena, double dt = 1.0);
+    
+    // Bit-reproducible one-tick move in 16.16 fixed point. Position and velocity must
+    // already lie on the 16.16 grid (see snapToFixed), and stay there afterwards
+    template<bool Gravity = true>
+    void moveFixed(const Arena& arena);
+    void snapToFixed();
+    void draw(SDL_Renderer* renderer, const Camera& camera) const;
+    void drawQuad(SDL_Renderer* renderer, const Camera& camera) const; // One filled rect; for reduced quality
+    void serve(const Arena& arena, Pcg32& rng);
     void reverseX();
     void reverseY();
     
@@ -30,8 +48,8 @@ public:
     double getCenterY() const;
     
 private:
-    void applyGravityWell();
-    
-    // Static random number generator shared by all Ball instances
-    static std::mt19937& getRandomGenerator();
+    int substepsFor(const Arena& arena, double dt) const;
+    static Vector2 gravityAcceleration(const Vector2& center, const Arena& arena);
+    static void gravityAccelerationFixed(FixedPoint::Fixed centerX, FixedPoint::Fixed centerY, const Arena& arena,
+                                         FixedPoint::Fixed& accelX, FixedPoint::Fixed& accelY);
 }; 
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "Arena.h"
+#include "Ball.h"
+
+// Maps world coordinates in the arena to window pixels. When the arena fits in the
+// window the camera is fixed and drawing is unchanged; in a larger arena it follows
+// the balls and can be zoomed out until the whole arena is visible.
+class Camera {
+public:
+    static constexpr float MAX_ZOOM = 2.0f;
+    static constexpr double FOLLOW_RATE = 0.1; // Fraction of the distance to the target covered per tick
+
+    Camera(int viewWidth, int viewHeight);
+
+    // Frame the arena at 1:1 (centered if it is smaller than the view)
+    void reset(const Arena& arena);
+    void follow(const std::vector<Ball>& balls, const Arena& arena);
+    void zoomBy(float factor, const Arena& arena);
+
+    float getZoom() const { return zoom; }
+
+    // Narrow the view to part of the screen (nullptr restores the whole view), so
+    // culling against getViewRect and isVisible also skips things outside that part
+    void setClip(const SDL_Rect* screenArea);
+
+    // Visible part of the world, in world units
+    SDL_FRect getViewRect() const;
+    bool isVisible(double x, double y, double w, double h) const;
+
+    float toScreenX(double worldX) const { return static_cast<float>((worldX - viewX) * zoom); }
+    float toScreenY(double worldY) const { return static_cast<float>((worldY - viewY) * zoom); }
+    SDL_FRect toScreen(double x, double y, double w, double h) const;
+
+private:
+    int viewWidth, viewHeight;
+    double viewX, viewY; // World position of the view's top-left corner
+    float zoom;
+    bool clipped;
+    SDL_FRect clip; // World units; only used while clipped
+
+    float minZoom(const Arena& arena) const;
+    void centerOn(double worldX, double worldY, const Arena& arena);
+};
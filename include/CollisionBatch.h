@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Arena.h"
+#include "Ball.h"
+#include "Paddle.h"
+#include "PhysicsProfile.h"
+
+// Broad phase for balls against the top and bottom walls and both paddles, run on all
+// balls at once. Positions are copied into flat float arrays and a single branch-free
+// pass (which the compiler vectorizes) compares every ball with the wall limits and
+// both paddle boxes, leaving the indices of the few balls that might touch something.
+// The float test is widened by MARGIN on every side, so it never misses a contact the
+// exact double and integer tests would find; callers run those only on the candidates.
+class CollisionBatch {
+public:
+    static constexpr float MARGIN = 2.0f; // Covers float rounding and the integer truncation of ball rects
+    static constexpr size_t LANES = 8;    // Balls per block of the compare pass
+
+    // Candidates come out in ball order
+    void build(const std::vector<Ball>& balls, const Arena& arena, WallMode walls,
+               const Paddle& leftPaddle, const Paddle& rightPaddle);
+    // Tests only the balls listed in subset (ascending indices into balls); candidates are
+    // still indices into balls
+    void build(const std::vector<Ball>& balls, const std::vector<int>& subset, const Arena& arena,
+               WallMode walls, const Paddle& leftPaddle, const Paddle& rightPaddle);
+
+    const std::vector<int>& getCandidates() const { return candidates; }
+
+    // Heap bytes held by the scratch arrays
+    size_t getMemoryUsage() const;
+
+private:
+    std::vector<float> ballX, ballY, ballVelX;
+    std::vector<uint32_t> hits;
+    std::vector<int> candidates;
+
+    // Runs the compare pass over balls gathered into the arrays; index maps an array
+    // position back to its ball (nullptr when they match)
+    void compare(size_t count, int size, const int* index, const Arena& arena, WallMode walls,
+                 const Paddle& leftPaddle, const Paddle& rightPaddle);
+    void resize(size_t count);
+};
@@ -20,6 +20,8 @@ public:
     static const int WIN_SCORE = 10;
     static const int FPS = 60;
     static const int FRAME_DELAY = 1000 / FPS;
+    static const int FRAME_DURATION_US = 1000000 / FPS;
+    static const int FRAME_SPIN_US = 500;  // Busy-wait only this close to a frame deadline
     
     // Paddle starting positions
     static const int LEFT_PADDLE_START_X = 20;
@@ -31,4 +33,8 @@ public:
     static const int GRAVITY_CENTER_Y = WINDOW_HEIGHT / 2;
     static constexpr double GRAVITY_RADIUS = 200.0;
     static constexpr double GRAVITY_STRENGTH = 0.15;
+    
+    // Integration: inside the gravity well each substep moves a ball at most this far
+    static constexpr double GRAVITY_MAX_STEP = 2.0;
+    static const int MAX_SUBSTEPS = 16;
 }; 
\ No newline at end of file
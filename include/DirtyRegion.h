@@ -0,0 +1,51 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+
+// Tracks which parts of the window changed, on a coarse grid of tiles. Everything that
+// moves or animates marks its screen rect each frame; a frame then redraws the tiles
+// marked in this frame (new positions) or the previous one (positions to erase),
+// merged into a few rectangles. Most of the playfield is static black, so on the
+// software renderer this clears, draws and presents a small fraction of the window.
+class DirtyRegion {
+public:
+    static constexpr int TILE_SIZE = 32;
+    // Past this share of dirty tiles one full-window rect is cheaper than many small ones
+    static constexpr double FULL_REDRAW_FRACTION = 0.6;
+
+    DirtyRegion(int width, int height);
+
+    // Screen pixels; anything outside the window is ignored
+    void mark(const SDL_FRect& area);
+
+    // Redraw the whole window next frame (expose, camera move, score change)
+    void markAll();
+
+    // Rectangles to redraw this frame. Starts the next frame, so call once per frame.
+    const std::vector<SDL_Rect>& collect();
+
+    // Appends the index of each last collected rect that area (screen pixels) overlaps,
+    // once each, by looking up the tiles under it
+    void findRects(const SDL_FRect& area, std::vector<int>& out) const;
+
+    // Share of the window covered by the last collected rects
+    double getCoverage() const { return coverage; }
+
+private:
+    int width, height;
+    int columns, rows;
+    std::vector<uint8_t> current;  // Tiles marked this frame
+    std::vector<uint8_t> previous; // Tiles marked last frame
+    std::vector<int> tileRects;    // Collected rect covering each tile, -1 if it isn't redrawn
+    bool fullRedraw;
+    std::vector<SDL_Rect> rects;
+    double coverage;
+
+    // Rects still growing downward while rows are merged: (first column, last column, index in rects)
+    struct OpenRun {
+        int first, last;
+        size_t rect;
+    };
+    std::vector<OpenRun> openRuns, nextRuns;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+
+// 16.16 fixed-point arithmetic for the deterministic physics path. Everything past
+// fromDouble is integer math (square roots bit by bit, trig by CORDIC over a small
+// arctangent table), so results are bit-identical on every compiler, flag set and CPU.
+namespace FixedPoint {
+    using Fixed = int32_t;
+
+    constexpr int FRACTION_BITS = 16;
+    constexpr Fixed ONE = 1 << FRACTION_BITS;
+    constexpr Fixed PI = 205887;      // Nearest 16.16 value to pi
+    constexpr Fixed HALF_PI = 102944;
+
+    // Rounds half away from zero; exact for values that are already 16.16
+    constexpr Fixed fromDouble(double value) {
+        return static_cast<Fixed>(value * ONE + (value >= 0.0 ? 0.5 : -0.5));
+    }
+    constexpr Fixed fromInt(int value) { return value * ONE; }
+    constexpr double toDouble(Fixed value) { return value / static_cast<double>(ONE); }
+
+    inline Fixed multiply(Fixed a, Fixed b) {
+        return static_cast<Fixed>((static_cast<int64_t>(a) * b) >> FRACTION_BITS);
+    }
+    inline Fixed divide(Fixed a, Fixed b) {
+        return static_cast<Fixed>(static_cast<int64_t>(a) * ONE / b);
+    }
+
+    // Floor of the square root of a 64-bit integer
+    uint32_t isqrt(uint64_t value);
+
+    // sqrt(x^2 + y^2) without overflowing the 16.16 range in the intermediate
+    inline Fixed length(Fixed x, Fixed y) {
+        uint64_t squared = static_cast<uint64_t>(static_cast<int64_t>(x) * x) +
+                           static_cast<uint64_t>(static_cast<int64_t>(y) * y);
+        return static_cast<Fixed>(isqrt(squared));
+    }
+
+    Fixed atan2(Fixed y, Fixed x);
+    void sinCos(Fixed angle, Fixed& sine, Fixed& cosine);
+}
+
+// FNV-1a over the simulation state; two runs agree on the hash only if every
+// hashed value matched bit for bit
+class StateHash {
+public:
+    void add(uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * PRIME;
+        }
+    }
+    void add(uint64_t value) {
+        add(static_cast<uint32_t>(value));
+        add(static_cast<uint32_t>(value >> 32));
+    }
+    void add(int32_t value) { add(static_cast<uint32_t>(value)); }
+
+    uint64_t value() const { return hash; }
+
+private:
+    static constexpr uint64_t OFFSET_BASIS = 14695981039346656037ULL;
+    static constexpr uint64_t PRIME = 1099511628211ULL;
+    uint64_t hash = OFFSET_BASIS;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat {
+    Y4M,  // Single YUV4MPEG2 stream (4:2:0), playable by ffmpeg/mpv
+    RAW,  // Headerless RGBA frames back to back
+    PNG   // One numbered PNG file per frame
+};
+
+// Records rendered frames without stalling the game loop. The game thread copies
+// each frame into a buffer from a fixed pool and hands it to a writer thread that
+// does the encoding and file I/O. If the writer falls behind and the pool runs dry,
+// frames are dropped rather than making the game wait.
+//
+// SDL3 can only read a renderer's pixels back into a surface it allocates, so
+// captureFrame costs one frame-sized allocation and an extra copy per frame (and a GPU
+// sync on hardware renderers). When the frame is drawn into a surface the game owns,
+// captureSurface copies straight from it into the pool instead.
+class FrameCapture {
+public:
+    static constexpr int POOL_SIZE = 8;
+
+    FrameCapture();
+    ~FrameCapture();
+
+    bool start(const std::string& path, CaptureFormat format, int width, int height, int fps);
+    void stop();
+
+    // Must be called after drawing and before SDL_RenderPresent
+    void captureFrame(SDL_Renderer* renderer);
+    // For a renderer that draws into surface; flush it first
+    void captureSurface(const SDL_Surface* surface);
+
+    bool isActive() const { return active; }
+    uint64_t getCapturedFrames() const { return capturedFrames; }
+    uint64_t getDroppedFrames() const { return droppedFrames; }
+
+    static CaptureFormat formatFromPath(const std::string& path);
+
+private:
+    struct FrameBuffer {
+        std::vector<uint8_t> pixels; // Tightly packed RGBA32
+        uint64_t frameNumber;
+    };
+
+    bool active;
+    std::string outputPath;
+    CaptureFormat format;
+    int width, height, fps;
+
+    std::vector<FrameBuffer> pool;
+    std::vector<int> freeSlots;   // Buffers the game thread may fill
+    std::vector<int> readySlots;  // Filled buffers waiting for the writer, oldest first
+    std::mutex queueMutex;
+    std::condition_variable frameReady;
+    bool stopRequested;
+    std::thread writer;
+
+    uint64_t capturedFrames;
+    uint64_t droppedFrames;
+
+    // Writer-thread state
+    std::ofstream stream;
+    std::vector<uint8_t> encodeBuffer;
+    std::vector<uint8_t> scanlineBuffer;
+
+    bool takeFreeSlot(int& slot);
+    void submitSlot(int slot, bool copied);
+    bool copyToSlot(int slot, const SDL_Surface* surface);
+    void writerLoop();
+    void writeFrame(const FrameBuffer& frame);
+    void writeY4MFrame(const FrameBuffer& frame);
+    void writePngFrame(const FrameBuffer& frame);
+};
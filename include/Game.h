@@ -1,93 +1,130 @@
 #pragma once
 #include <SDL3/SDL.h>
-#include <SDL3_ttf/SDL_ttf.h>
 #include <string>
 #include <chrono>
 #include <vector>
 #include <memory>
-#include <random>
-#include "Paddle.h"
-#include "Ball.h"
-#include "PowerUp.h"
+#include "Arena.h"
+#include "Camera.h"
+#include "DirtyRegion.h"
+#include "SpatialGrid.h"
+#include "Match.h"
+#include "ParticleSystem.h"
+#include "QualityGovernor.h"
+#include "FrameCapture.h"
+#include "Telemetry.h"
+#include "Metrics.h"
+#include "AudioMixer.h"
+#include "TextRenderer.h"
 #include "Constants.h"
+#include "GameOptions.h"
 
-class Game {
+class Game : public MatchListener {
 public:
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     ~Game();
     
     bool initialize();
     void run();
     void cleanup();
     
+    // Per-frame timings of a stress run (GameOptions::scenario)
+    const std::vector<StressFrame>& getStressFrames() const { return stressFrames; }
+    
 private:
+    GameOptions options;
     SDL_Window* window;
     SDL_Renderer* renderer;
-    TTF_Font* font;
-    TTF_Font* smallFont;
+    TextRenderer text;
+    
+    // The simulation; declared before the particles that draw from its effects stream
+    Match match;
+    const Arena& arena;
     
-    Paddle leftPaddle;
-    Paddle rightPaddle;
-    std::vector<Ball> balls;
-    std::vector<std::unique_ptr<PowerUp>> powerUps;
+    Camera camera;
+    SpatialGrid ballGrid;
+    std::vector<int> visibleBalls; // Scratch: indices of balls in view this frame
+    std::vector<int> regionBalls;  // Scratch: indices of balls in the dirty region being drawn
     
-    int player1Score;
-    int player2Score;
-    int winner;
+    ParticleSystem particles;
+    FrameCapture capture;
+    Telemetry telemetry;
+    Metrics metrics;
+    AudioMixer audio;
     
     bool gameRunning;
-    bool gameOver;
     bool wPressed, sPressed, upPressed, downPressed;
-    bool roundInProgress;  // Track if balls are active in current round
-    bool scoreThisRound;   // Track if a score has happened this round
 
-    // Control inversion tracking
-    int lastPlayerToHit;   // 1 for left player, 2 for right player
-    bool player1ControlsInverted;
-    bool player2ControlsInverted;
-    std::chrono::high_resolution_clock::time_point controlInversionStart;
-    static constexpr float CONTROL_INVERSION_DURATION = 10.0f; // 10 seconds
+    // Frame pacing and idle power saving
+    bool vsyncActive;      // Presents block on vsync, so no manual sleeping is needed
+    bool windowVisible;    // Cleared while the window is hidden, minimized or occluded
+    bool needsRedraw;      // Set by events that require a repaint while idle
+    
+    // Software rendering straight into the window surface, redrawing and presenting only
+    // the regions that changed since the last frame
+    bool dirtyRects;
+    DirtyRegion dirty;
+    SDL_FRect lastView;
+    SDL_FRect lastPaddleAreas[2];
+    std::string lastScoreText;
+    
+    // Trades drawing detail for frame time when entity counts spike
+    QualityGovernor quality;
+    std::chrono::high_resolution_clock::time_point presentStart; // End of this frame's drawing work
+    
+    // Startup timing, reported once the first frame is on screen
+    std::chrono::high_resolution_clock::time_point startupBegin;
+    std::chrono::high_resolution_clock::time_point windowCreated;
+    bool firstFramePresented;
     
     std::chrono::high_resolution_clock::time_point lastFrameTime;
-    std::chrono::high_resolution_clock::time_point lastPowerUpSpawn;
     double currentFPS;
+    std::string fpsText;
+    uint32_t framesSinceFpsText;
+    
+    Pcg32 scenarioRng;
+    std::vector<StressFrame> stressFrames;
     
-    // Random number generation for power-up spawning
-    std::random_device rd;
-    std::mt19937 gen;
-    std::uniform_real_distribution<> powerUpSpawnDis;
-    std::uniform_real_distribution<> powerUpPositionDis;
+    static constexpr uint32_t THROTTLED_FPS_TEXT_FRAMES = 15; // FPS text refresh interval at reduced quality
+    static constexpr uint32_t STATE_HASH_INTERVAL = 60; // Ticks between STATE_HASH telemetry events
     
     void handleEvents();
+    void processEvent(const SDL_Event& e);
+    bool isIdle() const;
+    void waitForEvents();
+    void finishStartup();
+    void sleepUntil(std::chrono::high_resolution_clock::time_point deadline);
     void update();
     void render();
+    void markDirty(bool fpsTextChanged);
+    // areaIndex selects the particles prepared for area; ballIndices are the grid candidates for it
+    void drawScene(const SDL_Rect& area, size_t areaIndex, const std::vector<int>& ballIndices);
     
-    void updatePaddles();
-    void updateBalls();
-    void updatePowerUps();
-    void checkCollisions();
-    void handlePaddleCollision(Ball& ball, Paddle& paddle);
-    void checkScore();
-    void checkWinCondition();
-    void serveBall();
+    void updateParticles();
     void resetGame();
     void updateFPS();
     
-    // Power-up related methods
-    void spawnPowerUp();
-    void checkPowerUpCollisions();
-    void activateMultiball();
-    void activateInvertControls();
-    void updateControlInversion();
-    void clearAllBalls();
+    // MatchListener: sound, particles and telemetry for gameplay events
+    void onPaddleHit(const Ball& ball, int player, double impactPoint) override;
+    void onWallBounce(const Ball& ball) override;
+    void onBallCollision(float x, float y, double closingSpeed) override;
+    void onPowerUpSpawn(const PowerUp& powerUp) override;
+    void onPowerUpPickup(const PowerUp& powerUp, int player) override;
+    void onInversionStart(int player) override;
+    void onInversionEnd(int player) override;
+    void onRewind(int player, uint32_t ticks) override;
+    void onScore(int player, const Ball& ball) override;
+    void onMatchEnd(int winner) override;
     
     void drawField();
     void drawGravityWell();
+    std::string getScoreText() const;
     void drawScore();
+    bool refreshFpsText();
     void drawFPS();
-    void drawGameOver();
+    void drawGameOver(const SDL_Rect& area);
     void drawControlsHint();
     
-    void renderText(const std::string& text, int x, int y, TTF_Font* font = nullptr);
-    void renderTextCentered(const std::string& text, int y, TTF_Font* font = nullptr);
+    void renderText(const std::string& message, int x, int y, TextSize size = TextSize::LARGE);
+    void renderTextCentered(const std::string& message, int y, TextSize size = TextSize::LARGE);
 }; 
\ No newline at end of file
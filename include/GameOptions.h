@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "FrameCapture.h"
+#include "Match.h"
+#include "Scenario.h"
+
+// Settings chosen on the command line and handed to Game at construction
+struct GameOptions {
+    uint64_t seed = 0;  // Match seed for reproducible play; 0 picks a random one
+    bool vsync = false; // Pace frames with the display's vertical sync instead of sleeping
+    bool mute = false;  // Skip opening an audio device
+    bool offscreen = false; // Render with the offscreen video driver and software renderer (no window)
+    bool dirtyRects = true; // On the software renderer, redraw only the parts of the window that changed
+    int qualityLevel = -1;  // Render detail: -1 adapts to frame time, 0 (full) to 4 (cheapest) holds a level
+
+    // Frame capture; disabled while capturePath is empty
+    std::string capturePath;
+    CaptureFormat captureFormat = CaptureFormat::RAW;
+    int captureFrameLimit = 0; // Quit after this many captured frames (0 = unlimited)
+
+    std::string telemetryPath; // Binary match event log; disabled while empty
+    int metricsPort = 0;       // Serve Prometheus metrics on 127.0.0.1:<port>; 0 disables
+
+    // Arena size, ball count and physics; an arena larger than the window scrolls with a camera
+    MatchRules rules;
+
+    // Headless server: run this many bot matches on a thread pool instead of opening a window
+    int serverRooms = 0;
+    int serverThreads = 0;          // 0 uses one per hardware thread
+    double serverDuration = 10.0;   // Seconds before the server prints its report and exits
+
+    // Rendered stress run: hold the field at scenarioBalls balls and quit after the scenario's ticks
+    const Scenario* scenario = nullptr;
+    int scenarioBalls = 0;
+};
@@ -0,0 +1,205 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Arena.h"
+#include "Ball.h"
+#include "CollisionBatch.h"
+#include "Paddle.h"
+#include "PowerUp.h"
+#include "PhysicsProfile.h"
+#include "Random.h"
+#include "SpatialGrid.h"
+#include "StateHistory.h"
+
+// Rules a match is played with, fixed from the first serve to the final point
+struct MatchRules {
+    Arena arena;
+    int ballCount = 1;           // Balls served at the start of each round
+    bool gravity = true;         // Pull balls toward the gravity well
+    bool ballCollisions = false; // Balls bounce off each other
+    WallMode wallMode = WallMode::BOUNCE;
+    bool fixedPoint = false;     // Deterministic 16.16 ball physics
+    bool rewind = true;          // Offer the REWIND power-up; keeps a few MB of per-tick history
+    int multiballCount = 5;      // Balls a MULTIBALL pickup splits into
+    bool eventFlight = true;     // Skip balls in straight flight until their next possible contact
+};
+
+// One player's paddle controls for a tick
+struct PaddleInput {
+    bool up = false;
+    bool down = false;
+};
+
+// Wall-clock seconds spent in each part of Match::tick, summed over ticks while attached
+struct TickPhaseTimes {
+    double movement = 0.0;   // Paddles and ball integration
+    double collisions = 0.0; // Walls, paddles, ball-ball and scoring
+    double powerUps = 0.0;   // Expiry, spawning, pickups and the inversion timer
+    double history = 0.0;    // REWIND snapshots
+};
+
+// Receives gameplay events as they happen inside Match::tick, for effects, sound
+// and logging. Every callback defaults to doing nothing.
+class MatchListener {
+public:
+    virtual ~MatchListener() = default;
+
+    virtual void onPaddleHit(const Ball& /*ball*/, int /*player*/, double /*impactPoint*/) {}
+    virtual void onWallBounce(const Ball& /*ball*/) {}
+    virtual void onBallCollision(float /*x*/, float /*y*/, double /*closingSpeed*/) {}
+    virtual void onPowerUpSpawn(const PowerUp& /*powerUp*/) {}
+    virtual void onPowerUpPickup(const PowerUp& /*powerUp*/, int /*player*/) {}
+    virtual void onInversionStart(int /*player*/) {}
+    virtual void onInversionEnd(int /*player*/) {}
+    virtual void onRewind(int /*player*/, uint32_t /*ticks*/) {}
+    virtual void onScore(int /*player*/, const Ball& /*ball*/) {}
+    virtual void onMatchEnd(int /*winner*/) {}
+};
+
+// The simulation of a single match: paddles, balls, power-ups, score and the seeded
+// random streams, with no window, sound or rendering attached. The game drives one
+// Match from the keyboard; the room host runs hundreds of them with bots.
+class Match {
+public:
+    static constexpr float CONTROL_INVERSION_DURATION = 10.0f; // 10 seconds
+    static constexpr float REWIND_SECONDS = 3.0f;
+
+    // Rewind history bounds. Ticks with more balls or power-ups than this aren't
+    // captured; a rewind that lands among them goes back to the last tick that was.
+    static constexpr int HISTORY_TICKS = 8 * Constants::FPS;
+    static constexpr size_t HISTORY_BYTES = 2 << 20;
+    static constexpr int MAX_SNAPSHOT_BALLS = 256;
+    static constexpr int MAX_SNAPSHOT_POWERUPS = 4;
+
+    // Event-driven flight: contact zones are widened by this much (world units) when
+    // planning, and no plan runs longer than MAX_COAST_TICKS
+    static constexpr double FLIGHT_MARGIN = 2.0;
+    static constexpr uint32_t MAX_COAST_TICKS = 3600;
+
+    Match(const MatchRules& rules, uint64_t seed);
+
+    // Events go to the listener; nullptr silences them
+    void setListener(MatchListener* matchListener);
+
+    // Time the phases of every tick into times; nullptr (the default) stops timing
+    void setPhaseTimes(TickPhaseTimes* times);
+
+    // Advance one tick. Does nothing once the match is over
+    void tick(const PaddleInput& left, const PaddleInput& right);
+
+    // Start a new match with the same rules, continuing the random streams
+    void reset();
+
+    // Put extra entities on the field outside the normal serve and spawn schedule, e.g.
+    // to load a stress scenario. Neither touches the match's random streams.
+    void addBall(const Ball& ball);
+    void addPowerUp(int x, int y, PowerUpType type);
+
+    uint64_t computeStateHash() const;
+
+    // Bytes owned by the match, itself included, for sizing rooms on a server
+    size_t getMemoryUsage() const;
+
+    const MatchRules& getRules() const { return rules; }
+    const Arena& getArena() const { return rules.arena; }
+    uint64_t getSeed() const { return seed; }
+    WorldRng& getRng() { return rng; }
+
+    const Paddle& getLeftPaddle() const { return leftPaddle; }
+    const Paddle& getRightPaddle() const { return rightPaddle; }
+    const std::vector<Ball>& getBalls() const { return balls; }
+    const std::vector<std::unique_ptr<PowerUp>>& getPowerUps() const { return powerUps; }
+
+    int getPlayer1Score() const { return player1Score; }
+    int getPlayer2Score() const { return player2Score; }
+    int getWinner() const { return winner; }
+    bool isOver() const { return gameOver; }
+    uint32_t getTickCount() const { return tickCount; }
+    uint32_t getElapsedTicks() const { return elapsedTicks; }
+    int getCollisionChecks() const { return collisionChecks; }
+
+private:
+    MatchRules rules;
+    uint64_t seed;
+    WorldRng rng;
+    MatchListener* listener;
+    TickPhaseTimes* phaseTimes;
+
+    Paddle leftPaddle;
+    Paddle rightPaddle;
+    std::vector<Ball> balls;
+    std::vector<std::unique_ptr<PowerUp>> powerUps;
+
+    int player1Score;
+    int player2Score;
+    int winner;
+    bool gameOver;
+    bool roundInProgress;  // Track if balls are active in current round
+    bool scoreThisRound;   // Track if a score has happened this round
+
+    // Control inversion tracking
+    int lastPlayerToHit;   // 1 for left player, 2 for right player
+    bool player1ControlsInverted;
+    bool player2ControlsInverted;
+    uint32_t controlInversionStartTick;
+
+    uint32_t lastPowerUpSpawnTick;
+    uint32_t tickCount;    // Simulation ticks since the match was created; a rewind winds it back
+    uint32_t elapsedTicks; // Ticks actually run, never wound back; for logs and hash timing
+    int collisionChecks;   // Collision tests performed during the current tick
+
+    // Balls coast between planned events (MatchRules::eventFlight). Off with ball-ball
+    // collisions, where any neighbour can change a ball's path.
+    bool eventFlight;
+
+    // Tick specialized for the rules' PhysicsProfile, chosen at match start
+    using TickFunction = void (Match::*)(const PaddleInput&, const PaddleInput&);
+    TickFunction tickFunction;
+
+    // Scratch for ball-ball collisions; left empty unless the rules enable them
+    SpatialGrid collisionGrid;
+    std::vector<int> nearbyBalls;
+    CollisionBatch contactBatch; // Scratch for ball-wall and ball-paddle tests
+    std::vector<int> liveBalls;  // Balls not coasting this tick, with event flight
+
+    // Per-tick snapshots for REWIND; only allocated when the rules offer it
+    static constexpr int HEADER_WORDS = 15;
+    static constexpr int BALL_WORDS = 8;
+    static constexpr int POWERUP_WORDS = 5;
+    std::unique_ptr<StateHistory> history;
+    std::vector<uint32_t> snapshot;
+    bool rewindPending;   // Picked up this tick; applied once the tick is done
+    int rewindPlayer;
+
+    void selectPhysicsProfile();
+
+    template<typename Profile> void tickWith(const PaddleInput& left, const PaddleInput& right);
+    template<typename Profile> void updateBalls();
+    template<typename Profile> void checkCollisions();
+    template<bool FixedPoint> void resolveBallCollisions();
+    template<typename Profile> void resolveContacts(Ball& ball);
+    template<typename Profile> void planFlights();
+    template<typename Profile> double ticksToContact(const Ball& ball) const;
+    void wakeAllBalls();
+    void updatePaddles(const PaddleInput& left, const PaddleInput& right);
+    void updatePowerUps();
+    void handlePaddleCollision(Ball& ball, Paddle& paddle);
+    void checkScore();
+    void checkWinCondition();
+    void serveBall();
+    void clearAllBalls();
+
+    // Power-up related methods
+    void spawnPowerUp();
+    void checkPowerUpCollisions();
+    void activateMultiball();
+    void activateInvertControls();
+    void updateControlInversion();
+    void activateRewind();
+    bool canRewind() const;
+
+    void captureHistory();
+    int writeSnapshot(uint32_t* words) const;
+    void readSnapshot(const uint32_t* words);
+};
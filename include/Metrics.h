@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// Live counters for a running instance, served in Prometheus text format on
+// localhost. The game loop only performs relaxed atomic updates; formatting and
+// socket work happen entirely on the server thread, so scraping does not touch
+// frame time.
+class Metrics {
+public:
+    Metrics();
+    ~Metrics();
+
+    bool startServer(int port);
+    void stopServer();
+
+    // Game thread
+    void recordFrame(double workSeconds, bool missedDeadline);
+    void recordTick(int ballCount, int powerUpCount, int particleCount, int collisionChecks);
+    void recordStartup(double secondsToWindow, double windowToFirstFrameSeconds);
+    void recordRedraw(double windowFraction);
+    void recordQuality(int level);
+
+    std::string renderPrometheus() const;
+
+private:
+    // Upper bounds of the frame-time histogram buckets in seconds (+Inf is implicit)
+    static constexpr int FRAME_BUCKET_COUNT = 10;
+    static constexpr double FRAME_BUCKET_BOUNDS[FRAME_BUCKET_COUNT] = {
+        0.001, 0.002, 0.004, 0.008, 0.012, 0.0167, 0.025, 0.033, 0.05, 0.1
+    };
+
+    std::atomic<uint64_t> frameBuckets[FRAME_BUCKET_COUNT + 1];
+    std::atomic<uint64_t> frameCount;
+    std::atomic<uint64_t> frameTimeSumNs;
+    std::atomic<uint64_t> droppedFrames;
+
+    std::atomic<uint64_t> tickCount;
+    std::atomic<uint64_t> collisionChecksTotal;
+    std::atomic<int> lastCollisionChecks;
+    std::atomic<int> balls;
+    std::atomic<int> powerUps;
+    std::atomic<int> particles;
+    std::atomic<double> redrawFraction;
+    std::atomic<int> qualityLevel;
+    std::atomic<double> startupToWindow;
+    std::atomic<double> windowToFirstFrame;
+
+    std::atomic<bool> serverRunning;
+    int listenSocket;
+    std::thread server;
+
+    void serverLoop();
+};
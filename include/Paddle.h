@@ -3,17 +3,20 @@
 #include "Vector2.h"
 #include "Constants.h"
 
+class Camera;
+
 class Paddle {
 public:
     Vector2 position;
     int width, height;
     int speed;
+    int boundsHeight; // Height of the arena the paddle moves in
     
-    Paddle(int x, int y, int width, int height, int speed);
+    Paddle(int x, int y, int width, int height, int speed, int boundsHeight = Constants::WINDOW_HEIGHT);
     
     void moveUp();
     void moveDown();
-    void draw(SDL_Renderer* renderer);
+    void draw(SDL_Renderer* renderer, const Camera& camera) const;
     
     // Collision detection helpers
     bool intersects(const SDL_Rect& other) const;
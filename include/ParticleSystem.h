@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "Random.h"
+
+class Camera;
+class DirtyRegion;
+
+// Fixed-capacity particle pool for cosmetic effects (trails, sparks, bursts).
+// Particles live in a structure-of-arrays ring buffer: emitting never allocates,
+// and when the pool is full the oldest particles are overwritten.
+class ParticleSystem {
+public:
+    static constexpr int CAPACITY = 1 << 16; // Must stay a power of two for ring indexing
+
+    explicit ParticleSystem(Pcg32& random);
+
+    void emit(float x, float y, float velX, float velY, float lifeTicks, float size, SDL_Color color);
+
+    // Convenience emitters used by the game
+    void emitBurst(float x, float y, int count, float speed, float lifeTicks, SDL_Color color);
+    void emitSparks(float x, float y, float dirX, int count, SDL_Color color);
+    void emitTrail(float x, float y, float velX, float velY);
+    void emitSwirl(float centerX, float centerY, float radius, int count);
+
+    void update();
+
+    // Builds the quads of every particle in view once per frame and groups them by the
+    // rects of region they overlap (all into rect 0 when region is null), so drawing
+    // a rect submits only its own particles however many rects the frame has
+    void prepareDraw(const Camera& camera, const DirtyRegion* region, size_t rectCount);
+    void draw(SDL_Renderer* renderer, size_t rect);
+
+    void markDirty(DirtyRegion& region, const Camera& camera) const;
+    void clear();
+
+    int getLiveCount() const { return static_cast<int>(head - tail); }
+
+private:
+    static constexpr uint32_t INDEX_MASK = CAPACITY - 1;
+    static constexpr float DRAG = 0.96f;
+
+    // Structure-of-arrays storage so the update loop streams through contiguous floats
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life, invMaxLife;
+    std::vector<float> size;
+    std::vector<uint32_t> color; // Packed 0xRRGGBB
+
+    // Ring bounds as monotonically increasing counters; after update() every slot in
+    // [tail, head) is live
+    uint64_t head;
+    uint64_t tail;
+
+    // Preallocated draw buffers: one quad per visible particle, and the quad indices of
+    // each rect back to back, rect r's running from rectStarts[r] to rectStarts[r + 1]
+    std::vector<SDL_Vertex> vertices;
+    int preparedQuads;
+    std::vector<int> indices;
+    std::vector<size_t> rectStarts;
+    std::vector<int> quadRects; // (quad, rect) pairs found while building the quads
+    std::vector<int> overlapped;
+
+    Pcg32& random; // The world's effects stream
+
+    uint32_t updateSpan(uint32_t begin, uint32_t end); // Returns how many particles expired
+};
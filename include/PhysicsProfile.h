@@ -0,0 +1,18 @@
+#pragma once
+
+enum class WallMode {
+    BOUNCE, // Balls reflect off the top and bottom walls
+    WRAP    // Balls leaving through the top reappear at the bottom and vice versa
+};
+
+// Compile-time description of the rules a match is played with. The ball update and
+// collision code is instantiated once per profile, so a disabled rule has no branch
+// or call in the tick at all; Match picks the matching instantiation when a match starts.
+// FixedPoint swaps the floating-point ball physics for the bit-reproducible 16.16 path.
+template<bool Gravity, bool BallCollisions, WallMode Walls, bool FixedPoint = false>
+struct PhysicsProfile {
+    static constexpr bool gravity = Gravity;
+    static constexpr bool ballCollisions = BallCollisions;
+    static constexpr WallMode walls = Walls;
+    static constexpr bool fixedPoint = FixedPoint;
+};
@@ -2,11 +2,14 @@
 #include <SDL3/SDL.h>
 #include "Vector2.h"
 #include "Constants.h"
-#include <chrono>
+#include <cstdint>
+
+class Camera;
 
 enum class PowerUpType {
     MULTIBALL,
-    INVERT_CONTROLS
+    INVERT_CONTROLS,
+    REWIND          // Turns the match back a few seconds
 };
 
 class PowerUp {
@@ -14,13 +17,13 @@ public:
     Vector2 position;
     int width, height;
     PowerUpType type;
-    std::chrono::high_resolution_clock::time_point spawnTime;
+    uint32_t spawnTick;
     bool active;
     
-    PowerUp(int x, int y, PowerUpType powerUpType);
+    PowerUp(int x, int y, PowerUpType powerUpType, uint32_t spawnTick);
     
-    void draw(SDL_Renderer* renderer);
-    bool isExpired() const;
+    void draw(SDL_Renderer* renderer, uint32_t currentTick, const Camera& camera, bool animate = true);
+    bool isExpired(uint32_t currentTick) const;
     SDL_Rect getRect() const;
     
 private:
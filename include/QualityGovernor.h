@@ -0,0 +1,54 @@
+#pragma once
+
+// Render detail, from full polish down to the cheapest frame. Each level keeps the
+// reductions of the levels above it.
+enum class QualityLevel {
+    FULL,            // Everything drawn as designed
+    THROTTLED_HUD,   // FPS text refreshed a few times a second instead of every frame
+    STATIC_POWERUPS, // Power-ups drawn without the pulse animation
+    PLAIN_WELL,      // Gravity well without its radial lines
+    QUAD_BALLS       // Balls filled as squares instead of point-plotted discs
+};
+
+// Watches how long each frame takes to simulate and render and trades polish for
+// frame rate. A burst of frames over budget steps detail down one level; detail comes
+// back one level at a time only after a sustained stretch with plenty of headroom.
+// If a step back up is quickly undone, the next one waits twice as long, so a load
+// that sits right at the edge settles instead of flickering between levels; steps
+// up that hold shorten the wait again.
+class QualityGovernor {
+public:
+    static constexpr int WINDOW_FRAMES = 15;               // Frames per evaluation (a quarter second)
+    static constexpr double OVER_BUDGET_FRACTION = 0.85;   // A frame this close to the budget counts as slow
+    static constexpr int SLOW_FRAMES_TO_DROP = 3;          // Slow frames in a window that step detail down
+    static constexpr double HEADROOM_FRACTION = 0.5;       // Average below this share of budget is headroom
+    static constexpr int RAISE_DELAY_WINDOWS = 8;          // Windows of headroom before stepping up (2 s)
+    static constexpr int MAX_RAISE_DELAY_WINDOWS = 120;    // Back-off cap (30 s)
+
+    explicit QualityGovernor(double budgetSeconds);
+
+    // Disable adaptation and hold one level
+    void pin(QualityLevel level);
+
+    // Feed the work time of each frame; returns true when the level changed
+    bool recordFrame(double workSeconds);
+
+    QualityLevel getLevel() const { return level; }
+    bool throttleHud() const { return level >= QualityLevel::THROTTLED_HUD; }
+    bool animatePowerUps() const { return level < QualityLevel::STATIC_POWERUPS; }
+    bool drawWellLines() const { return level < QualityLevel::PLAIN_WELL; }
+    bool roundBalls() const { return level < QualityLevel::QUAD_BALLS; }
+
+private:
+    double budget;
+    QualityLevel level;
+    bool pinned;
+
+    int windowFrames;
+    int slowFrames;
+    double windowWork;
+    int headroomWindows;
+    int raiseDelayWindows;
+    int windowsSinceRaise;
+    bool droppedSinceRaise;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+// PCG32 (XSH-RR variant, O'Neill 2014): small, fast and fully reproducible from
+// (seed, stream). Generators with the same seed but different streams produce
+// independent sequences, which lets each subsystem draw numbers without
+// perturbing the others.
+class Pcg32 {
+public:
+    Pcg32() : Pcg32(0, 0) {}
+    Pcg32(uint64_t seed, uint64_t stream) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        increment = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Uniform in [0, 1)
+    double nextDouble() { return next() * (1.0 / 4294967296.0); }
+    float nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    uint64_t getState() const { return state; }
+    void setState(uint64_t value) { state = value; } // Resume a sequence saved with getState
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+// All randomness for one world, split by purpose. Gameplay streams (serve, spawn)
+// are never touched by cosmetic effects, so a match replays identically from its
+// seed no matter how many particles were drawn.
+struct WorldRng {
+    enum Stream : uint64_t {
+        SERVE_STREAM = 1,
+        SPAWN_STREAM = 2,
+        EFFECTS_STREAM = 3
+    };
+
+    explicit WorldRng(uint64_t seed)
+        : serve(seed, SERVE_STREAM), spawn(seed, SPAWN_STREAM), effects(seed, EFFECTS_STREAM) {}
+
+    Pcg32 serve;
+    Pcg32 spawn;
+    Pcg32 effects;
+};
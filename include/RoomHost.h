@@ -0,0 +1,75 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "Match.h"
+
+// Runs many independent matches ("rooms") in one process, with bots on both paddles.
+// A fixed pool of workers shares one queue of rooms ordered by their next tick
+// deadline: whichever worker is free takes the most overdue room, so load balances
+// itself and a slow room never holds up the others behind it on a particular thread.
+class RoomHost {
+public:
+    // A room further behind than this skips ahead instead of bursting to catch up
+    static constexpr int MAX_CATCHUP_TICKS = 5;
+    // Lateness histogram resolution and range; later ticks land in the last bucket
+    static constexpr int LATENESS_BUCKET_US = 50;
+    static constexpr int LATENESS_BUCKET_COUNT = 2000;
+
+    RoomHost(const MatchRules& rules, int roomCount, int threadCount, uint64_t seed);
+
+    // Ticks every room at Constants::FPS on the worker pool until the duration elapses
+    void run(double seconds);
+
+    void printReport(std::ostream& out) const;
+
+    // Paddle controls for a bot chasing the nearest ball headed its way
+    static PaddleInput botInput(const Match& match, const Paddle& paddle, bool leftSide);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Room {
+        Match match;
+        int id;
+        Clock::time_point deadline; // When the next tick is due
+
+        uint32_t ticks = 0;
+        uint32_t lateTicks = 0;     // Ticks started more than a full period after their deadline
+        uint32_t skippedTicks = 0;  // Ticks dropped after falling too far behind
+        uint32_t matchesPlayed = 0;
+        int64_t latenessSumUs = 0;
+        int64_t maxLatenessUs = 0;
+
+        Room(const MatchRules& rules, uint64_t seed, int roomId) : match(rules, seed), id(roomId) {}
+    };
+
+    // Each worker records into its own histogram; merged only for the report
+    struct WorkerStats {
+        std::vector<uint64_t> latenessBuckets = std::vector<uint64_t>(LATENESS_BUCKET_COUNT, 0);
+        uint64_t ticks = 0;
+        double busySeconds = 0.0;
+    };
+
+    using Deadline = std::pair<Clock::time_point, int>; // (due time, room index)
+
+    int threadCount;
+    Clock::duration period;
+    std::vector<std::unique_ptr<Room>> rooms;
+    std::vector<WorkerStats> workerStats;
+    double elapsedSeconds;
+
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> schedule;
+    std::mutex scheduleMutex;
+    std::condition_variable scheduleChanged;
+    bool stopping;
+
+    void workerLoop(int worker, Clock::time_point endTime);
+    void tickRoom(Room& room, WorkerStats& stats);
+};
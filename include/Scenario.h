@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Match.h"
+#include "Random.h"
+
+// Where a scenario puts the balls it adds
+enum class SpawnPattern {
+    CENTER, // All at the gravity well, heading off in random directions
+    GRID,   // Evenly spaced over the arena between the paddles
+    RANDOM, // Anywhere between the paddles
+    RING    // On a circle around the well, heading outward
+};
+
+// One rendered frame of a stress run, in seconds
+struct StressFrame {
+    double simulate;
+    double render;
+    int entities; // Balls, power-ups and particles on the field
+};
+
+// A stress test loaded from a scenario file: the rules to play by, how to fill the
+// field, and a sweep of ball counts, each held for a fixed number of ticks. Files are
+// "key = value" lines with # comments:
+//
+//   name = collision crowd
+//   balls = 10 100 1000       # one run per count
+//   pattern = grid            # center, grid, random or ring
+//   speed = 3 6               # launch speed range in pixels per tick
+//   power_ups = 2             # kept on the field at all times
+//   ticks = 600               # per ball count
+//
+// plus the match rules: arena = <w>x<h>, gravity, collisions, fixed_point, rewind and
+// event_flight = on/off, walls = bounce/wrap and multiball = <balls per split>.
+struct Scenario {
+    static constexpr uint64_t PLACEMENT_STREAM = 4; // Pcg32 stream for populate, apart from WorldRng's
+
+    std::string name;
+    MatchRules rules;
+    std::vector<int> ballCounts;
+    SpawnPattern pattern = SpawnPattern::RANDOM;
+    double minSpeed = Constants::BALL_SPEED;
+    double maxSpeed = Constants::BALL_SPEED;
+    int powerUps = 0;
+    int ticks = 600;
+
+    // Reports problems on std::cerr with the file and line
+    static bool load(const std::string& path, Scenario& scenario);
+
+    // Top the field back up to ballCount balls and the scenario's power-ups, starting a
+    // new match if the last one ended. Placement draws only from rng, never from the match.
+    void populate(Match& match, int ballCount, Pcg32& rng) const;
+
+private:
+    Ball spawnBall(const Arena& arena, int index, int ballCount, Pcg32& rng) const;
+};
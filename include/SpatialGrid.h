@@ -0,0 +1,33 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "Arena.h"
+#include "Ball.h"
+
+// Uniform grid over the arena, rebuilt from scratch each frame with a counting sort
+// (two passes over the balls, no per-cell allocations). Rendering asks it for the
+// balls overlapping the camera view instead of walking every ball in the arena.
+class SpatialGrid {
+public:
+    static constexpr int CELL_SIZE = 64;
+
+    SpatialGrid();
+
+    void build(const std::vector<Ball>& balls, const Arena& arena);
+
+    // Appends the indices of balls whose cell overlaps the rect (world units) to out.
+    // Candidates are per cell, so callers that need exact overlap test each one.
+    void query(const SDL_FRect& area, std::vector<int>& out) const;
+
+    // Heap bytes held by the cell and scratch arrays
+    size_t getMemoryUsage() const;
+
+private:
+    int columns, rows;
+    std::vector<int> cellStart; // Offsets into items, one past the end per cell (size columns*rows + 1)
+    std::vector<int> items;     // Ball indices grouped by cell
+    std::vector<int> ballCells; // Scratch: the cell each ball was binned into
+    std::vector<int> cursor;    // Scratch: next free slot per cell while scattering
+
+    int cellFor(double x, double y) const;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer/single-consumer queue. push() is only ever called from
+// one thread and pop() from one other thread; neither blocks nor allocates.
+// Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0), cachedTail(0), cachedHead(0) {}
+
+    // Producer side. Returns false when the queue is full.
+    bool push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - cachedTail == Capacity) {
+            // Refresh our view of the consumer only when we appear to be full
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h - cachedTail == Capacity) return false;
+        }
+        buffer[h & MASK] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the queue is empty.
+    bool pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t == cachedHead) return false;
+        }
+        item = buffer[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    // Producer and consumer indices on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    alignas(64) size_t cachedTail; // Producer's last seen tail
+    alignas(64) size_t cachedHead; // Consumer's last seen head
+    T buffer[Capacity];
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bounded per-tick history of a world snapshot, for rewinding. Snapshots are flat
+// arrays of 32-bit words. Each is XORed with the previous tick's snapshot and only
+// the nonzero bytes are kept: a tag byte per four words gives each word's size
+// (0, 1, 2 or 4 bytes). Anything that didn't move therefore costs almost nothing.
+// Every KEYFRAME_INTERVAL snapshots, and whenever the layout changes size, a snapshot
+// is stored against zero instead. Restoring any held tick decodes at most one
+// keyframe plus KEYFRAME_INTERVAL - 1 deltas. Everything is allocated up front;
+// capture never allocates, and the oldest ticks are dropped when space runs out.
+class StateHistory {
+public:
+    static constexpr int KEYFRAME_INTERVAL = 32;
+
+    StateHistory(int maxWords, size_t byteCapacity, int tickCapacity);
+
+    void clear();
+
+    // Ticks must increase but may skip; skipped ticks just aren't held. A tick that
+    // doesn't increase starts the history over.
+    void capture(uint32_t tick, const uint32_t* words, int count);
+
+    // Oldest tick that can be restored; false if the history is empty
+    bool getOldestTick(uint32_t& tick) const;
+    bool getNewestTick(uint32_t& tick) const;
+
+    // Rebuilds the newest held snapshot at or before tick and forgets everything captured
+    // after it, so capture continues from there. The returned words stay valid until the
+    // next call.
+    const uint32_t* rewindTo(uint32_t tick, int& count);
+
+    size_t getMemoryUsage() const;
+
+private:
+    struct Entry {
+        uint32_t tick;
+        uint32_t offset; // Into bytes
+        uint32_t length;
+        uint32_t words;
+        bool keyframe;
+    };
+
+    int maxWords;
+    std::vector<uint8_t> bytes;
+    std::vector<Entry> entries; // Ring, one per captured tick
+    std::vector<uint32_t> previous; // Last captured snapshot
+    std::vector<uint32_t> restored;
+    int previousCount;
+
+    int firstEntry;      // Ring index of the oldest entry
+    int entryCount;
+    int deltaRun;        // Deltas stored since the newest keyframe
+    uint32_t writeOffset;
+
+    Entry& entryAt(int age) { return entries[(firstEntry + age) % entries.size()]; }
+    const Entry& entryAt(int age) const { return entries[(firstEntry + age) % entries.size()]; }
+    void dropOldest();
+    uint32_t encode(const uint32_t* words, const uint32_t* base, int count, uint8_t* out) const;
+    void decode(const Entry& entry, uint32_t* words) const;
+};
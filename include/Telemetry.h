@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include "SpscRing.h"
+
+enum class TelemetryEventType : uint8_t {
+    MATCH_START = 1,
+    MATCH_END,
+    PADDLE_HIT,       // a = impact point on paddle (-1..1), b = ball speed after the hit
+    WALL_BOUNCE,      // detail = 0 top / 1 bottom, a/b = velocity after the bounce
+    POWERUP_SPAWN,    // detail = PowerUpType
+    POWERUP_PICKUP,   // detail = PowerUpType, player = last player to hit the ball
+    INVERSION_START,  // player = whose controls were inverted
+    INVERSION_END,
+    SCORE,            // player = who scored, a/b = scores after the point
+    BALL_COLLISION,   // x/y = contact point, a = closing speed along the contact normal
+    STATE_HASH,       // Fixed-point mode only: x/y hold the raw low/high 32 bits of the state hash
+    REWIND            // player = who collected it, a = ticks of match state rewound
+};
+
+// Fixed-size binary record; the log file is a header followed by these back to back
+struct TelemetryEvent {
+    uint32_t tick;    // Ticks the match has run; keeps counting up through a rewind
+    uint8_t type;     // TelemetryEventType
+    uint8_t player;   // 1 or 2, 0 when not applicable
+    uint8_t detail;   // Type-specific
+    uint8_t reserved;
+    float x, y;       // Where it happened
+    float a, b;       // Type-specific payload
+};
+static_assert(sizeof(TelemetryEvent) == 24, "TelemetryEvent is part of the on-disk format");
+
+struct TelemetryFileHeader {
+    char magic[8];      // "PONGTEL\0"
+    uint32_t version;
+    uint32_t eventSize;
+};
+
+// Per-match analytics stream. The game thread pushes events into a lock-free
+// SPSC ring and a background thread drains them to disk, so emit() never
+// blocks, locks or allocates; if the writer falls behind, events are dropped
+// and counted instead.
+class Telemetry {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t RING_CAPACITY = 8192;
+
+    Telemetry();
+    ~Telemetry();
+
+    bool start(const std::string& path);
+    void stop();
+    bool isActive() const { return active; }
+
+    void emit(TelemetryEventType type, uint32_t tick, uint8_t player, uint8_t detail,
+              float x, float y, float a = 0.0f, float b = 0.0f) {
+        if (!active) return;
+        TelemetryEvent event = {tick, static_cast<uint8_t>(type), player, detail, 0, x, y, a, b};
+        if (!ring->push(event)) {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    bool active;
+    std::unique_ptr<SpscRing<TelemetryEvent, RING_CAPACITY>> ring;
+    std::atomic<bool> writerRunning;
+    std::atomic<uint64_t> droppedEvents;
+    std::thread writer;
+    FILE* file;
+    uint64_t writtenEvents;
+
+    void writerLoop();
+    size_t drain();
+};
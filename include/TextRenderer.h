@@ -0,0 +1,62 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string>
+
+enum class TextSize {
+    LARGE, // Score and headlines
+    SMALL  // HUD and hints
+};
+
+// Owns the game's fonts. The font file is read from disk once and both sizes are
+// opened from that single in-memory copy. If no system font can be found, text
+// falls back to SDL's built-in bitmap font so the game still starts. Glyphs for
+// the score are rasterized one per draw call after the first frame and then drawn
+// from cached textures, laid out with the font's own advances and kerning so cached
+// text is exactly as wide as a full TTF render.
+class TextRenderer {
+public:
+    static constexpr int LARGE_POINT_SIZE = 36;
+    static constexpr int SMALL_POINT_SIZE = 12;
+
+    TextRenderer();
+    ~TextRenderer();
+
+    void initialize(SDL_Renderer* renderer);
+    void shutdown();
+
+    // Start filling the score glyph cache; call once the first frame is up
+    void startGlyphWarmup();
+    // Rasterize the next score glyph while warmup is running; call once per frame
+    void warmGlyphs();
+
+    void draw(const std::string& text, int x, int y, TextSize size);
+    void drawCentered(const std::string& text, int y, int areaWidth, TextSize size);
+
+    bool isUsingFallbackFont() const { return !largeFont; }
+
+private:
+    static constexpr const char* CACHED_GLYPHS = " 0123456789:";
+    static constexpr int CACHED_GLYPH_COUNT = 12;
+
+    SDL_Renderer* renderer;
+    bool ttfInitialized;
+    void* fontData;
+    size_t fontDataSize;
+    TTF_Font* largeFont;
+    TTF_Font* smallFont;
+
+    // Score glyph cache. SDL_ttf fonts are not safe to use from two threads, so the
+    // glyphs are rasterized on the rendering thread, a single one per frame.
+    int nextWarmGlyph; // -1 until warmup starts
+    SDL_Texture* glyphTextures[CACHED_GLYPH_COUNT];
+    int glyphAdvances[CACHED_GLYPH_COUNT];
+    bool glyphTexturesReady;
+
+    bool loadFontData();
+    void warmNextGlyph();
+    bool drawFromGlyphCache(const std::string& text, int x, int y);
+    void drawFallback(const std::string& text, int x, int y, TextSize size);
+    TTF_Font* fontFor(TextSize size) const { return size == TextSize::LARGE ? largeFont : smallFont; }
+    static float fallbackScale(TextSize size) { return size == TextSize::LARGE ? 4.0f : 2.0f; }
+};
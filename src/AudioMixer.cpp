@@ -0,0 +1,142 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// A decaying sine sweep; enough to give each event a distinct, readable sound
+std::vector<float> synthesizeTone(double startHz, double endHz, double seconds, double decay) {
+    int length = static_cast<int>(seconds * AudioMixer::SAMPLE_RATE);
+    std::vector<float> samples(length);
+    double phase = 0.0;
+    for (int i = 0; i < length; i++) {
+        double t = static_cast<double>(i) / length;
+        double frequency = startHz + (endHz - startHz) * t;
+        phase += 2.0 * M_PI * frequency / AudioMixer::SAMPLE_RATE;
+        double envelope = std::exp(-decay * t) * std::min(1.0, i / 48.0); // Short attack avoids clicks
+        samples[i] = static_cast<float>(0.5 * envelope * std::sin(phase));
+    }
+    return samples;
+}
+
+} // namespace
+
+AudioMixer::AudioMixer()
+    : stream(nullptr), voices() {
+}
+
+AudioMixer::~AudioMixer() {
+    shutdown();
+}
+
+bool AudioMixer::initialize() {
+    // Ask for small device buffers to keep event-to-sound latency under a frame
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, "256");
+
+    if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        std::cerr << "Audio unavailable, continuing without sound. SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    synthesizeSounds();
+    mixBuffer.assign(MIX_CHUNK_FRAMES * CHANNELS, 0.0f);
+
+    SDL_AudioSpec spec = {SDL_AUDIO_F32, CHANNELS, SAMPLE_RATE};
+    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, audioCallback, this);
+    if (!stream) {
+        std::cerr << "Could not open audio device, continuing without sound. SDL_Error: " << SDL_GetError() << std::endl;
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+
+    SDL_ResumeAudioStreamDevice(stream);
+    return true;
+}
+
+void AudioMixer::shutdown() {
+    if (!stream) return;
+    SDL_DestroyAudioStream(stream);
+    stream = nullptr;
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+void AudioMixer::synthesizeSounds() {
+    sounds[static_cast<int>(SoundEffect::PADDLE_HIT)] = synthesizeTone(440.0, 440.0, 0.06, 5.0);
+    sounds[static_cast<int>(SoundEffect::WALL_BOUNCE)] = synthesizeTone(220.0, 220.0, 0.04, 5.0);
+    sounds[static_cast<int>(SoundEffect::POWERUP)] = synthesizeTone(600.0, 1200.0, 0.2, 2.0);
+    sounds[static_cast<int>(SoundEffect::SCORE)] = synthesizeTone(400.0, 150.0, 0.35, 3.0);
+}
+
+void AudioMixer::play(SoundEffect effect, float volume, float pan) {
+    if (!stream) return;
+    // A full queue means the audio thread is stalled; dropping the sound is the right call
+    commands.push({effect, volume, std::clamp(pan, -1.0f, 1.0f)});
+}
+
+void AudioMixer::startVoice(const PlayCommand& command) {
+    // Take a free voice, otherwise steal the one closest to finishing
+    Voice* target = &voices[0];
+    for (Voice& voice : voices) {
+        if (!voice.samples) {
+            target = &voice;
+            break;
+        }
+        if (voice.length - voice.position < target->length - target->position) {
+            target = &voice;
+        }
+    }
+
+    const std::vector<float>& sound = sounds[static_cast<int>(command.effect)];
+    // Equal-power pan
+    float angle = (command.pan + 1.0f) * 0.25f * static_cast<float>(M_PI);
+    target->samples = sound.data();
+    target->length = static_cast<int>(sound.size());
+    target->position = 0;
+    target->gainLeft = command.volume * std::cos(angle);
+    target->gainRight = command.volume * std::sin(angle);
+}
+
+void SDLCALL AudioMixer::audioCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int /*totalAmount*/) {
+    if (additionalAmount > 0) {
+        static_cast<AudioMixer*>(userdata)->mix(stream, additionalAmount);
+    }
+}
+
+void AudioMixer::mix(SDL_AudioStream* audioStream, int bytesNeeded) {
+    PlayCommand command;
+    while (commands.pop(command)) {
+        startVoice(command);
+    }
+
+    const int bytesPerFrame = static_cast<int>(sizeof(float)) * CHANNELS;
+    int framesNeeded = (bytesNeeded + bytesPerFrame - 1) / bytesPerFrame;
+
+    while (framesNeeded > 0) {
+        int frames = std::min(framesNeeded, MIX_CHUNK_FRAMES);
+        float* out = mixBuffer.data();
+        std::fill(out, out + frames * CHANNELS, 0.0f);
+
+        for (Voice& voice : voices) {
+            if (!voice.samples) continue;
+            int count = std::min(frames, voice.length - voice.position);
+            const float* in = voice.samples + voice.position;
+            for (int i = 0; i < count; i++) {
+                out[i * 2] += in[i] * voice.gainLeft;
+                out[i * 2 + 1] += in[i] * voice.gainRight;
+            }
+            voice.position += count;
+            if (voice.position >= voice.length) {
+                voice.samples = nullptr;
+            }
+        }
+
+        // Hard clip; overlapping effects are rare and brief
+        for (int i = 0; i < frames * CHANNELS; i++) {
+            out[i] = std::clamp(out[i], -1.0f, 1.0f);
+        }
+
+        SDL_PutAudioStreamData(audioStream, out, frames * bytesPerFrame);
+        framesNeeded -= frames;
+    }
+}
@@ -1,33 +1,114 @@
 #include "Ball.h"
+#include "Camera.h"
 #include <cmath>
 #include <algorithm>
-#include <random>
 
 Ball::Ball(int x, int y, int size)
-    : position(x, y), width(size), height(size) {
+    : position(x, y), width(size), height(size), coastUntil(0) {
 }
 
-std::mt19937& Ball::getRandomGenerator() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return gen;
+template<bool Gravity>
+void Ball::move(const Arena& arena, double dt) {
+    if constexpr (!Gravity) {
+        position += velocity * dt;
+        return;
+    }
+    
+    int substeps = substepsFor(arena, dt);
+    double h = dt / substeps;
+    Vector2 halfExtent(width / 2.0, height / 2.0);
+    
+    // Velocity Verlet: second-order accurate and stable for orbits, so trajectories
+    // near the well no longer depend on the frame rate the way explicit Euler did
+    Vector2 acceleration = gravityAcceleration(position + halfExtent, arena);
+    for (int i = 0; i < substeps; i++) {
+        velocity += acceleration * (h * 0.5);
+        position += velocity * h;
+        acceleration = gravityAcceleration(position + halfExtent, arena);
+        velocity += acceleration * (h * 0.5);
+    }
+}
+
+template void Ball::move<true>(const Arena& arena, double dt);
+template void Ball::move<false>(const Arena& arena, double dt);
+
+template<bool Gravity>
+void Ball::moveFixed(const Arena& arena) {
+    using namespace FixedPoint;
+    Fixed posX = fromDouble(position.x), posY = fromDouble(position.y);
+    Fixed velX = fromDouble(velocity.x), velY = fromDouble(velocity.y);
+    
+    if constexpr (!Gravity) {
+        posX += velX;
+        posY += velY;
+    } else {
+        Fixed halfWidth = fromInt(width) / 2, halfHeight = fromInt(height) / 2;
+        
+        // Same substep rule as move(): one step unless the ball can reach the well this tick
+        Fixed travel = length(velX, velY);
+        int64_t deltaX = fromInt(arena.width) / 2 - (posX + halfWidth);
+        int64_t deltaY = fromInt(arena.height) / 2 - (posY + halfHeight);
+        int64_t reach = fromDouble(Constants::GRAVITY_RADIUS) + travel;
+        int substeps = 1;
+        if (deltaX * deltaX + deltaY * deltaY < reach * reach) {
+            Fixed maxStep = fromDouble(Constants::GRAVITY_MAX_STEP);
+            substeps = std::clamp((travel + maxStep - 1) / maxStep, 1, Constants::MAX_SUBSTEPS);
+        }
+        Fixed h = ONE / substeps;
+        Fixed halfH = h / 2;
+        
+        Fixed accelX, accelY;
+        gravityAccelerationFixed(posX + halfWidth, posY + halfHeight, arena, accelX, accelY);
+        for (int i = 0; i < substeps; i++) {
+            velX += multiply(accelX, halfH);
+            velY += multiply(accelY, halfH);
+            posX += multiply(velX, h);
+            posY += multiply(velY, h);
+            gravityAccelerationFixed(posX + halfWidth, posY + halfHeight, arena, accelX, accelY);
+            velX += multiply(accelX, halfH);
+            velY += multiply(accelY, halfH);
+        }
+    }
+    
+    position.x = toDouble(posX);
+    position.y = toDouble(posY);
+    velocity.x = toDouble(velX);
+    velocity.y = toDouble(velY);
+}
+
+template void Ball::moveFixed<true>(const Arena& arena);
+template void Ball::moveFixed<false>(const Arena& arena);
+
+void Ball::snapToFixed() {
+    using namespace FixedPoint;
+    position.x = toDouble(fromDouble(position.x));
+    position.y = toDouble(fromDouble(position.y));
+    velocity.x = toDouble(fromDouble(velocity.x));
+    velocity.y = toDouble(fromDouble(velocity.y));
 }
 
-void Ball::move() {
-    // Apply gravity well effect before moving
-    applyGravityWell();
+int Ball::substepsFor(const Arena& arena, double dt) const {
+    // Outside the well the flight is a straight line, which one step integrates exactly.
+    // Only balls that can reach the field this tick pay for extra substeps.
+    double travel = velocity.magnitude() * dt;
+    double deltaX = arena.centerX() - (position.x + width / 2.0);
+    double deltaY = arena.centerY() - (position.y + height / 2.0);
+    double reach = Constants::GRAVITY_RADIUS + travel;
+    if (deltaX * deltaX + deltaY * deltaY >= reach * reach) {
+        return 1;
+    }
     
-    position.x += velocity.x;
-    position.y += velocity.y;
+    int substeps = static_cast<int>(std::ceil(travel / Constants::GRAVITY_MAX_STEP));
+    return std::clamp(substeps, 1, Constants::MAX_SUBSTEPS);
 }
 
-void Ball::draw(SDL_Renderer* renderer) const {
+void Ball::draw(SDL_Renderer* renderer, const Camera& camera) const {
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
     
     // Draw circle by drawing multiple points
-    int centerX = static_cast<int>(position.x + width / 2);
-    int centerY = static_cast<int>(position.y + height / 2);
-    int radius = width / 2;
+    int centerX = static_cast<int>(camera.toScreenX(position.x + width / 2));
+    int centerY = static_cast<int>(camera.toScreenY(position.y + height / 2));
+    int radius = static_cast<int>(width / 2 * camera.getZoom());
     
     for (int y = -radius; y <= radius; ++y) {
         for (int x = -radius; x <= radius; ++x) {
@@ -38,16 +119,19 @@ void Ball::draw(SDL_Renderer* renderer) const {
     }
 }
 
-void Ball::serve() {
-    position.x = Constants::WINDOW_WIDTH / 2.0 - width / 2.0;
-    position.y = Constants::WINDOW_HEIGHT / 2.0 - height / 2.0;
-    
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    auto& gen = getRandomGenerator();
+void Ball::drawQuad(SDL_Renderer* renderer, const Camera& camera) const {
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
+    SDL_FRect rect = camera.toScreen(position.x, position.y, width, height);
+    SDL_RenderFillRect(renderer, &rect);
+}
+
+void Ball::serve(const Arena& arena, Pcg32& rng) {
+    position.x = arena.centerX() - width / 2.0;
+    position.y = arena.centerY() - height / 2.0;
     
     // Give the ball a stronger initial boost to escape the gravity well
-    velocity.x = (dis(gen) < 0.5 ? Constants::BALL_SPEED : -Constants::BALL_SPEED) * Constants::SERVE_SPEED_MULTIPLIER;
-    velocity.y = (dis(gen) - 0.5) * Constants::BALL_SPEED * Constants::SERVE_SPEED_MULTIPLIER;
+    velocity.x = (rng.nextDouble() < 0.5 ? Constants::BALL_SPEED : -Constants::BALL_SPEED) * Constants::SERVE_SPEED_MULTIPLIER;
+    velocity.y = (rng.nextDouble() - 0.5) * Constants::BALL_SPEED * Constants::SERVE_SPEED_MULTIPLIER;
 }
 
 void Ball::reverseX() {
@@ -71,50 +155,58 @@ double Ball::getCenterY() const {
     return position.y + height / 2.0;
 }
 
-void Ball::applyGravityWell() {
+Vector2 Ball::gravityAcceleration(const Vector2& center, const Arena& arena) {
     // Calculate vector from ball center to gravity well center
-    double ballCenterX = position.x + width / 2.0;
-    double ballCenterY = position.y + height / 2.0;
-    double deltaX = Constants::GRAVITY_CENTER_X - ballCenterX;
-    double deltaY = Constants::GRAVITY_CENTER_Y - ballCenterY;
+    double deltaX = arena.centerX() - center.x;
+    double deltaY = arena.centerY() - center.y;
     
     // Use squared distance for performance (avoid sqrt when possible)
     double distanceSquared = deltaX * deltaX + deltaY * deltaY;
     double radiusSquared = Constants::GRAVITY_RADIUS * Constants::GRAVITY_RADIUS;
     
     // Only apply gravity if ball is within the gravity radius
-    if (distanceSquared < radiusSquared) {
-        // Calculate actual distance (now we need sqrt for the force calculation)
-        double distance = std::sqrt(distanceSquared);
-        
-        // Avoid division by zero when ball is exactly at center
-        if (distance > 0.1) {
-            // Linear force scaling: stronger when closer to center
-            // force = GRAVITY_STRENGTH × (1 − distance / GRAVITY_RADIUS)
-            double forceFactor = Constants::GRAVITY_STRENGTH * (1.0 - distance / Constants::GRAVITY_RADIUS);
-            
-            // Normalize the direction vector (deltaX, deltaY) and apply force
-            double normalizedDeltaX = deltaX / distance;
-            double normalizedDeltaY = deltaY / distance;
-            
-            // Calculate the proposed force components
-            double forceX = normalizedDeltaX * forceFactor;
-            double forceY = normalizedDeltaY * forceFactor;
-            
-            // Cap the force to not exceed 10% of base speed in any single frame
-            double maxForce = Constants::BALL_SPEED * 0.1;
-            double currentForce = std::sqrt(forceX * forceX + forceY * forceY);
-            
-            if (currentForce > maxForce) {
-                // Scale down the force to the maximum allowed
-                double scaleFactor = maxForce / currentForce;
-                forceX *= scaleFactor;
-                forceY *= scaleFactor;
-            }
-            
-            // Apply the gravity force to the ball's velocity
-            velocity.x += forceX;
-            velocity.y += forceY;
-        }
+    if (distanceSquared >= radiusSquared) {
+        return Vector2();
     }
-} 
\ No newline at end of file
+    
+    // Calculate actual distance (now we need sqrt for the force calculation)
+    double distance = std::sqrt(distanceSquared);
+    
+    // Avoid division by zero when ball is exactly at center
+    if (distance <= 0.1) {
+        return Vector2();
+    }
+    
+    // Linear force scaling: stronger when closer to center
+    // force = GRAVITY_STRENGTH × (1 − distance / GRAVITY_RADIUS)
+    double forceFactor = Constants::GRAVITY_STRENGTH * (1.0 - distance / Constants::GRAVITY_RADIUS);
+    
+    // Normalized direction towards the center, scaled by the force (per tick squared)
+    return Vector2(deltaX / distance * forceFactor, deltaY / distance * forceFactor);
+}
+
+void Ball::gravityAccelerationFixed(FixedPoint::Fixed centerX, FixedPoint::Fixed centerY, const Arena& arena,
+                                    FixedPoint::Fixed& accelX, FixedPoint::Fixed& accelY) {
+    using namespace FixedPoint;
+    accelX = accelY = 0;
+    
+    Fixed deltaX = fromInt(arena.width) / 2 - centerX;
+    Fixed deltaY = fromInt(arena.height) / 2 - centerY;
+    Fixed radius = fromDouble(Constants::GRAVITY_RADIUS);
+    
+    // Squared distances are 32.32, compared in 64 bits
+    int64_t distanceSquared = static_cast<int64_t>(deltaX) * deltaX + static_cast<int64_t>(deltaY) * deltaY;
+    if (distanceSquared >= static_cast<int64_t>(radius) * radius) {
+        return;
+    }
+    
+    Fixed distance = static_cast<Fixed>(isqrt(static_cast<uint64_t>(distanceSquared)));
+    if (distance <= fromDouble(0.1)) {
+        return;
+    }
+    
+    // force = GRAVITY_STRENGTH × (1 − distance / GRAVITY_RADIUS), directed at the center
+    int64_t force = static_cast<int64_t>(fromDouble(Constants::GRAVITY_STRENGTH)) * (radius - distance) / radius;
+    accelX = static_cast<Fixed>(deltaX * force / distance);
+    accelY = static_cast<Fixed>(deltaY * force / distance);
+}
@@ -0,0 +1,87 @@
+#include "Camera.h"
+#include <algorithm>
+
+Camera::Camera(int viewWidth, int viewHeight)
+    : viewWidth(viewWidth), viewHeight(viewHeight), viewX(0.0), viewY(0.0), zoom(1.0f),
+      clipped(false), clip{0.0f, 0.0f, 0.0f, 0.0f} {
+}
+
+void Camera::reset(const Arena& arena) {
+    zoom = 1.0f;
+    centerOn(arena.centerX(), arena.centerY(), arena);
+}
+
+void Camera::follow(const std::vector<Ball>& balls, const Arena& arena) {
+    if (arena.fitsWindow() || balls.empty()) return;
+
+    // Ease toward the middle of the balls in play
+    double targetX = 0.0, targetY = 0.0;
+    for (const auto& ball : balls) {
+        targetX += ball.position.x + ball.width / 2.0;
+        targetY += ball.getCenterY();
+    }
+    targetX /= balls.size();
+    targetY /= balls.size();
+
+    double currentX = viewX + viewWidth / (2.0 * zoom);
+    double currentY = viewY + viewHeight / (2.0 * zoom);
+    centerOn(currentX + (targetX - currentX) * FOLLOW_RATE,
+             currentY + (targetY - currentY) * FOLLOW_RATE, arena);
+}
+
+void Camera::zoomBy(float factor, const Arena& arena) {
+    double centerX = viewX + viewWidth / (2.0 * zoom);
+    double centerY = viewY + viewHeight / (2.0 * zoom);
+    zoom = std::clamp(zoom * factor, minZoom(arena), MAX_ZOOM);
+    centerOn(centerX, centerY, arena);
+}
+
+float Camera::minZoom(const Arena& arena) const {
+    // Zooming out past the point where the whole arena is visible only wastes pixels
+    float fitX = static_cast<float>(viewWidth) / arena.width;
+    float fitY = static_cast<float>(viewHeight) / arena.height;
+    return std::min(1.0f, std::min(fitX, fitY));
+}
+
+void Camera::centerOn(double worldX, double worldY, const Arena& arena) {
+    double visibleWidth = viewWidth / zoom;
+    double visibleHeight = viewHeight / zoom;
+
+    // Keep the view inside the arena; an axis smaller than the view stays centered
+    if (visibleWidth >= arena.width) {
+        viewX = (arena.width - visibleWidth) / 2.0;
+    } else {
+        viewX = std::clamp(worldX - visibleWidth / 2.0, 0.0, arena.width - visibleWidth);
+    }
+    if (visibleHeight >= arena.height) {
+        viewY = (arena.height - visibleHeight) / 2.0;
+    } else {
+        viewY = std::clamp(worldY - visibleHeight / 2.0, 0.0, arena.height - visibleHeight);
+    }
+}
+
+void Camera::setClip(const SDL_Rect* screenArea) {
+    clipped = screenArea != nullptr;
+    if (clipped) {
+        clip = {static_cast<float>(viewX + screenArea->x / zoom), static_cast<float>(viewY + screenArea->y / zoom),
+                screenArea->w / zoom, screenArea->h / zoom};
+    }
+}
+
+SDL_FRect Camera::getViewRect() const {
+    if (clipped) return clip;
+    return {static_cast<float>(viewX), static_cast<float>(viewY),
+            static_cast<float>(viewWidth / zoom), static_cast<float>(viewHeight / zoom)};
+}
+
+bool Camera::isVisible(double x, double y, double w, double h) const {
+    if (clipped) {
+        return x + w >= clip.x && x <= clip.x + clip.w && y + h >= clip.y && y <= clip.y + clip.h;
+    }
+    return x + w >= viewX && x <= viewX + viewWidth / zoom &&
+           y + h >= viewY && y <= viewY + viewHeight / zoom;
+}
+
+SDL_FRect Camera::toScreen(double x, double y, double w, double h) const {
+    return {toScreenX(x), toScreenY(y), static_cast<float>(w * zoom), static_cast<float>(h * zoom)};
+}
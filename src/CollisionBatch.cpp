@@ -0,0 +1,96 @@
+#include "CollisionBatch.h"
+#include <algorithm>
+#include <limits>
+
+void CollisionBatch::resize(size_t count) {
+    // Whole blocks of LANES; the padding is NaN, which fails every comparison and never hits
+    size_t padded = (count + LANES - 1) / LANES * LANES;
+    ballX.resize(padded);
+    ballY.resize(padded);
+    ballVelX.resize(padded);
+    hits.resize(padded);
+    candidates.clear();
+    std::fill(ballX.begin() + count, ballX.end(), std::numeric_limits<float>::quiet_NaN());
+    std::fill(ballY.begin() + count, ballY.end(), std::numeric_limits<float>::quiet_NaN());
+    std::fill(ballVelX.begin() + count, ballVelX.end(), std::numeric_limits<float>::quiet_NaN());
+}
+
+void CollisionBatch::build(const std::vector<Ball>& balls, const Arena& arena, WallMode walls,
+                           const Paddle& leftPaddle, const Paddle& rightPaddle) {
+    size_t count = balls.size();
+    resize(count);
+
+    // The largest ball stands in for all of them, which only ever widens the test
+    int size = 0;
+    for (size_t i = 0; i < count; i++) {
+        ballX[i] = static_cast<float>(balls[i].position.x);
+        ballY[i] = static_cast<float>(balls[i].position.y);
+        ballVelX[i] = static_cast<float>(balls[i].velocity.x);
+        size = std::max(size, std::max(balls[i].width, balls[i].height));
+    }
+    compare(count, size, nullptr, arena, walls, leftPaddle, rightPaddle);
+}
+
+void CollisionBatch::build(const std::vector<Ball>& balls, const std::vector<int>& subset, const Arena& arena,
+                           WallMode walls, const Paddle& leftPaddle, const Paddle& rightPaddle) {
+    size_t count = subset.size();
+    resize(count);
+
+    int size = 0;
+    for (size_t i = 0; i < count; i++) {
+        const Ball& ball = balls[subset[i]];
+        ballX[i] = static_cast<float>(ball.position.x);
+        ballY[i] = static_cast<float>(ball.position.y);
+        ballVelX[i] = static_cast<float>(ball.velocity.x);
+        size = std::max(size, std::max(ball.width, ball.height));
+    }
+    compare(count, size, subset.data(), arena, walls, leftPaddle, rightPaddle);
+}
+
+void CollisionBatch::compare(size_t count, int size, const int* index, const Arena& arena, WallMode walls,
+                             const Paddle& leftPaddle, const Paddle& rightPaddle) {
+    size_t padded = hits.size();
+
+    // Bounce tests the ball's top edge against the walls, wrap its center against the edges
+    float wallTop = MARGIN;
+    float wallBottom = static_cast<float>(arena.height) - (walls == WallMode::BOUNCE ? size : size / 2.0f) - MARGIN;
+
+    // Ranges of top-left corners whose box comes within MARGIN of each paddle
+    float leftMinX = static_cast<float>(leftPaddle.position.x) - size - MARGIN;
+    float leftMaxX = static_cast<float>(leftPaddle.position.x) + leftPaddle.width + MARGIN;
+    float leftMinY = static_cast<float>(leftPaddle.position.y) - size - MARGIN;
+    float leftMaxY = static_cast<float>(leftPaddle.position.y) + leftPaddle.height + MARGIN;
+    float rightMinX = static_cast<float>(rightPaddle.position.x) - size - MARGIN;
+    float rightMaxX = static_cast<float>(rightPaddle.position.x) + rightPaddle.width + MARGIN;
+    float rightMinY = static_cast<float>(rightPaddle.position.y) - size - MARGIN;
+    float rightMaxY = static_cast<float>(rightPaddle.position.y) + rightPaddle.height + MARGIN;
+
+    // Branch-free, 32-bit lanes throughout and a fixed inner trip count, so the compiler
+    // turns it into packed compares even at -O2. Paddles only count balls heading into
+    // them; <= and >= keep velocities that round to zero as candidates.
+    const float* __restrict px = ballX.data();
+    const float* __restrict py = ballY.data();
+    const float* __restrict vx = ballVelX.data();
+    uint32_t* __restrict hit = hits.data();
+    for (size_t block = 0; block < padded; block += LANES) {
+        for (size_t lane = 0; lane < LANES; lane++) {
+            size_t i = block + lane;
+            float x = px[i], y = py[i];
+            uint32_t wall = (y <= wallTop) | (y >= wallBottom);
+            uint32_t left = (x > leftMinX) & (x < leftMaxX) & (y > leftMinY) & (y < leftMaxY) & (vx[i] <= 0.0f);
+            uint32_t right = (x > rightMinX) & (x < rightMaxX) & (y > rightMinY) & (y < rightMaxY) & (vx[i] >= 0.0f);
+            hit[i] = wall | left | right;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (hit[i]) {
+            candidates.push_back(index ? index[i] : static_cast<int>(i));
+        }
+    }
+}
+
+size_t CollisionBatch::getMemoryUsage() const {
+    return (ballX.capacity() + ballY.capacity() + ballVelX.capacity()) * sizeof(float) +
+           hits.capacity() * sizeof(uint32_t) + candidates.capacity() * sizeof(int);
+}
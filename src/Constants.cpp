@@ -12,10 +12,14 @@ constexpr double Constants::SERVE_SPEED_MULTIPLIER;
 const int Constants::WIN_SCORE;
 const int Constants::FPS;
 const int Constants::FRAME_DELAY;
+const int Constants::FRAME_DURATION_US;
+const int Constants::FRAME_SPIN_US;
 const int Constants::LEFT_PADDLE_START_X;
 const int Constants::RIGHT_PADDLE_START_X;
 const int Constants::PADDLE_START_Y;
 const int Constants::GRAVITY_CENTER_X;
 const int Constants::GRAVITY_CENTER_Y;
 constexpr double Constants::GRAVITY_RADIUS;
-constexpr double Constants::GRAVITY_STRENGTH; 
\ No newline at end of file
+constexpr double Constants::GRAVITY_STRENGTH;
+constexpr double Constants::GRAVITY_MAX_STEP;
+const int Constants::MAX_SUBSTEPS; 
\ No newline at end of file
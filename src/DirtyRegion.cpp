@@ -0,0 +1,115 @@
+#include "DirtyRegion.h"
+#include <algorithm>
+#include <cmath>
+
+DirtyRegion::DirtyRegion(int width, int height)
+    : width(width), height(height),
+      columns((width + TILE_SIZE - 1) / TILE_SIZE), rows((height + TILE_SIZE - 1) / TILE_SIZE),
+      current(columns * rows, 0), previous(columns * rows, 0), tileRects(columns * rows, 0),
+      fullRedraw(true), coverage(1.0) {
+}
+
+void DirtyRegion::mark(const SDL_FRect& area) {
+    if (area.x + area.w < -1.0f || area.y + area.h < -1.0f) return;
+
+    // Widen by a pixel so anti-aliased or rounded edges stay inside the marked tiles
+    int firstColumn = std::max(0, static_cast<int>(std::floor(area.x - 1.0f)) / TILE_SIZE);
+    int firstRow = std::max(0, static_cast<int>(std::floor(area.y - 1.0f)) / TILE_SIZE);
+    int lastColumn = std::min(columns - 1, static_cast<int>(std::ceil(area.x + area.w + 1.0f)) / TILE_SIZE);
+    int lastRow = std::min(rows - 1, static_cast<int>(std::ceil(area.y + area.h + 1.0f)) / TILE_SIZE);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        uint8_t* tile = &current[row * columns];
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            tile[column] = 1;
+        }
+    }
+}
+
+void DirtyRegion::markAll() {
+    fullRedraw = true;
+}
+
+const std::vector<SDL_Rect>& DirtyRegion::collect() {
+    rects.clear();
+
+    int dirtyTiles = 0;
+    for (size_t i = 0; i < current.size(); i++) {
+        dirtyTiles += current[i] | previous[i];
+    }
+
+    if (fullRedraw || dirtyTiles > FULL_REDRAW_FRACTION * columns * rows) {
+        rects.push_back({0, 0, width, height});
+        std::fill(tileRects.begin(), tileRects.end(), 0);
+    } else {
+        std::fill(tileRects.begin(), tileRects.end(), -1);
+        // Runs of dirty tiles along each row; a run spanning the same columns as one in
+        // the row above extends that rect downward instead of starting a new one
+        openRuns.clear();
+        for (int row = 0; row < rows; row++) {
+            nextRuns.clear();
+            int column = 0;
+            while (column < columns) {
+                int index = row * columns + column;
+                if (!(current[index] | previous[index])) {
+                    column++;
+                    continue;
+                }
+                int first = column;
+                while (column < columns && (current[row * columns + column] | previous[row * columns + column])) {
+                    column++;
+                }
+                int last = column - 1;
+
+                auto above = std::find_if(openRuns.begin(), openRuns.end(), [&](const OpenRun& run) {
+                    return run.first == first && run.last == last;
+                });
+                if (above != openRuns.end()) {
+                    rects[above->rect].h += TILE_SIZE;
+                    nextRuns.push_back(*above);
+                } else {
+                    rects.push_back({first * TILE_SIZE, row * TILE_SIZE, (last - first + 1) * TILE_SIZE, TILE_SIZE});
+                    nextRuns.push_back({first, last, rects.size() - 1});
+                }
+                std::fill_n(&tileRects[row * columns + first], last - first + 1, static_cast<int>(nextRuns.back().rect));
+            }
+            openRuns.swap(nextRuns);
+        }
+
+        // Edge tiles can hang off the window
+        for (auto& rect : rects) {
+            rect.w = std::min(rect.w, width - rect.x);
+            rect.h = std::min(rect.h, height - rect.y);
+        }
+    }
+
+    long long area = 0;
+    for (const auto& rect : rects) {
+        area += static_cast<long long>(rect.w) * rect.h;
+    }
+    coverage = static_cast<double>(area) / (static_cast<double>(width) * height);
+
+    previous.swap(current);
+    std::fill(current.begin(), current.end(), 0);
+    fullRedraw = false;
+    return rects;
+}
+
+void DirtyRegion::findRects(const SDL_FRect& area, std::vector<int>& out) const {
+    if (area.x + area.w < 0.0f || area.y + area.h < 0.0f || area.x >= width || area.y >= height) return;
+
+    int firstColumn = std::max(0, static_cast<int>(area.x) / TILE_SIZE);
+    int firstRow = std::max(0, static_cast<int>(area.y) / TILE_SIZE);
+    int lastColumn = std::min(columns - 1, static_cast<int>(area.x + area.w) / TILE_SIZE);
+    int lastRow = std::min(rows - 1, static_cast<int>(area.y + area.h) / TILE_SIZE);
+
+    size_t first = out.size();
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            int rect = tileRects[row * columns + column];
+            if (rect >= 0 && std::find(out.begin() + first, out.end(), rect) == out.end()) {
+                out.push_back(rect);
+            }
+        }
+    }
+}
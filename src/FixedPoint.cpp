@@ -0,0 +1,95 @@
+#include "FixedPoint.h"
+
+namespace FixedPoint {
+
+// atan(2^-i) in 16.16 radians, one entry per CORDIC iteration
+static const Fixed ATAN_TABLE[] = {
+    51472, 30386, 16055, 8150, 4091, 2047, 1024, 512,
+    256, 128, 64, 32, 16, 8, 4, 2
+};
+static const int CORDIC_ITERATIONS = 16;
+static const Fixed CORDIC_GAIN_INVERSE = 39797; // Product of cos(atan(2^-i)) over the iterations
+
+uint32_t isqrt(uint64_t value) {
+    // Digit-by-digit (binary restoring) square root
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+Fixed atan2(Fixed y, Fixed x) {
+    if (x == 0 && y == 0) return 0;
+
+    // Vectoring mode works for x >= 0; fold the left half-plane over first
+    int64_t vx = x, vy = y;
+    Fixed angle = 0;
+    if (vx < 0) {
+        angle = vy >= 0 ? PI : -PI;
+        vx = -vx;
+        vy = -vy;
+    }
+
+    // Rotate the vector onto the positive x axis, accumulating the angle turned
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        int64_t shiftedX = vx >> i;
+        int64_t shiftedY = vy >> i;
+        if (vy > 0) {
+            vx += shiftedY;
+            vy -= shiftedX;
+            angle += ATAN_TABLE[i];
+        } else {
+            vx -= shiftedY;
+            vy += shiftedX;
+            angle -= ATAN_TABLE[i];
+        }
+    }
+    return angle;
+}
+
+void sinCos(Fixed angle, Fixed& sine, Fixed& cosine) {
+    // Bring the angle into (-pi, pi], then into [-pi/2, pi/2] where CORDIC converges
+    while (angle > PI) angle -= 2 * PI;
+    while (angle <= -PI) angle += 2 * PI;
+    bool flip = false;
+    if (angle > HALF_PI) {
+        angle -= PI;
+        flip = true;
+    } else if (angle < -HALF_PI) {
+        angle += PI;
+        flip = true;
+    }
+
+    // Rotation mode: start from the gain-compensated unit vector and turn it by angle
+    int64_t vx = CORDIC_GAIN_INVERSE, vy = 0;
+    int64_t remaining = angle;
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        int64_t shiftedX = vx >> i;
+        int64_t shiftedY = vy >> i;
+        if (remaining >= 0) {
+            vx -= shiftedY;
+            vy += shiftedX;
+            remaining -= ATAN_TABLE[i];
+        } else {
+            vx += shiftedY;
+            vy -= shiftedX;
+            remaining += ATAN_TABLE[i];
+        }
+    }
+
+    cosine = static_cast<Fixed>(flip ? -vx : vx);
+    sine = static_cast<Fixed>(flip ? -vy : vy);
+}
+
+}
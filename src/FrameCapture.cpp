@@ -0,0 +1,326 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+uint32_t crc32Table[256];
+
+void buildCrc32Table() {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        crc32Table[n] = c;
+    }
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void appendBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Patches the length of a chunk opened with beginPngChunk and appends its CRC
+void finishPngChunk(std::vector<uint8_t>& out, size_t chunkStart) {
+    size_t payloadLength = out.size() - chunkStart - 8;
+    for (int i = 0; i < 4; i++) {
+        out[chunkStart + i] = static_cast<uint8_t>(payloadLength >> (24 - 8 * i));
+    }
+    appendBigEndian32(out, crc32(0, &out[chunkStart + 4], payloadLength + 4));
+}
+
+size_t beginPngChunk(std::vector<uint8_t>& out, const char* type) {
+    size_t start = out.size();
+    out.insert(out.end(), 4, 0); // Length, patched in finishPngChunk
+    out.insert(out.end(), type, type + 4);
+    return start;
+}
+
+} // namespace
+
+FrameCapture::FrameCapture()
+    : active(false), format(CaptureFormat::RAW), width(0), height(0), fps(0),
+      stopRequested(false), capturedFrames(0), droppedFrames(0) {
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+CaptureFormat FrameCapture::formatFromPath(const std::string& path) {
+    auto endsWith = [&path](const std::string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".y4m")) return CaptureFormat::Y4M;
+    if (endsWith(".png")) return CaptureFormat::PNG;
+    return CaptureFormat::RAW;
+}
+
+bool FrameCapture::start(const std::string& path, CaptureFormat captureFormat, int frameWidth, int frameHeight, int framesPerSecond) {
+    if (active) stop();
+
+    outputPath = path;
+    format = captureFormat;
+    width = frameWidth;
+    height = frameHeight;
+    fps = framesPerSecond;
+
+    if (format == CaptureFormat::PNG) {
+        // Strip the extension; frames are written as <prefix>_000001.png
+        if (outputPath.size() > 4 && outputPath.compare(outputPath.size() - 4, 4, ".png") == 0) {
+            outputPath.resize(outputPath.size() - 4);
+        }
+        buildCrc32Table();
+    } else {
+        stream.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            std::cerr << "Could not open capture file: " << outputPath << std::endl;
+            return false;
+        }
+        if (format == CaptureFormat::Y4M) {
+            stream << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+        }
+    }
+
+    // All buffers are allocated up front; capturing a frame only copies into one
+    pool.assign(POOL_SIZE, FrameBuffer());
+    freeSlots.clear();
+    readySlots.clear();
+    freeSlots.reserve(POOL_SIZE);
+    readySlots.reserve(POOL_SIZE);
+    for (int i = 0; i < POOL_SIZE; i++) {
+        pool[i].pixels.resize(static_cast<size_t>(width) * height * 4);
+        freeSlots.push_back(i);
+    }
+
+    capturedFrames = 0;
+    droppedFrames = 0;
+    stopRequested = false;
+    active = true;
+    writer = std::thread(&FrameCapture::writerLoop, this);
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!active) return;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopRequested = true;
+    }
+    frameReady.notify_one();
+    writer.join();
+
+    if (stream.is_open()) stream.close();
+    active = false;
+
+    std::cout << "Capture finished: " << capturedFrames << " frames written to " << outputPath
+              << ", " << droppedFrames << " dropped" << std::endl;
+}
+
+void FrameCapture::captureFrame(SDL_Renderer* renderer) {
+    int slot;
+    if (!active || !takeFreeSlot(slot)) return;
+
+    // SDL3 has no read-back into caller memory; this surface is allocated every frame
+    SDL_Surface* surface = SDL_RenderReadPixels(renderer, nullptr);
+    bool copied = surface && copyToSlot(slot, surface);
+    if (surface) SDL_DestroySurface(surface);
+    submitSlot(slot, copied);
+}
+
+void FrameCapture::captureSurface(const SDL_Surface* surface) {
+    int slot;
+    if (!active || !takeFreeSlot(slot)) return;
+    submitSlot(slot, surface && copyToSlot(slot, surface));
+}
+
+bool FrameCapture::takeFreeSlot(int& slot) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (freeSlots.empty()) {
+        // Writer is behind; skip this frame rather than block the game
+        droppedFrames++;
+        return false;
+    }
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+    return true;
+}
+
+bool FrameCapture::copyToSlot(int slot, const SDL_Surface* surface) {
+    if (surface->w != width || surface->h != height) return false;
+    return SDL_ConvertPixels(width, height, surface->format, surface->pixels, surface->pitch,
+                             SDL_PIXELFORMAT_RGBA32, pool[slot].pixels.data(), width * 4);
+}
+
+void FrameCapture::submitSlot(int slot, bool copied) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (!copied) {
+        freeSlots.push_back(slot);
+        droppedFrames++;
+        return;
+    }
+    pool[slot].frameNumber = capturedFrames++;
+    readySlots.push_back(slot);
+    frameReady.notify_one();
+}
+
+void FrameCapture::writerLoop() {
+    for (;;) {
+        int slot;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            frameReady.wait(lock, [this] { return stopRequested || !readySlots.empty(); });
+            if (readySlots.empty()) {
+                return; // Stop requested and everything queued has been written
+            }
+            slot = readySlots.front();
+            readySlots.erase(readySlots.begin());
+        }
+
+        writeFrame(pool[slot]);
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        freeSlots.push_back(slot);
+    }
+}
+
+void FrameCapture::writeFrame(const FrameBuffer& frame) {
+    switch (format) {
+        case CaptureFormat::Y4M:
+            writeY4MFrame(frame);
+            break;
+        case CaptureFormat::RAW:
+            stream.write(reinterpret_cast<const char*>(frame.pixels.data()), frame.pixels.size());
+            break;
+        case CaptureFormat::PNG:
+            writePngFrame(frame);
+            break;
+    }
+}
+
+void FrameCapture::writeY4MFrame(const FrameBuffer& frame) {
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    size_t lumaSize = static_cast<size_t>(width) * height;
+    size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+    encodeBuffer.resize(lumaSize + 2 * chromaSize);
+
+    uint8_t* yPlane = encodeBuffer.data();
+    uint8_t* uPlane = yPlane + lumaSize;
+    uint8_t* vPlane = uPlane + chromaSize;
+    const uint8_t* rgba = frame.pixels.data();
+
+    // Full-range BT.601 (the "jpeg" chroma siting in the header) in 8-bit fixed point
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; x++) {
+            int r = row[x * 4], g = row[x * 4 + 1], b = row[x * 4 + 2];
+            yPlane[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>((77 * r + 150 * g + 29 * b) >> 8);
+        }
+    }
+
+    // Chroma from the average of each 2x2 block
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            int r = 0, g = 0, b = 0, samples = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                int y = std::min(cy * 2 + dy, height - 1);
+                for (int dx = 0; dx < 2; dx++) {
+                    int x = std::min(cx * 2 + dx, width - 1);
+                    const uint8_t* px = rgba + (static_cast<size_t>(y) * width + x) * 4;
+                    r += px[0]; g += px[1]; b += px[2];
+                    samples++;
+                }
+            }
+            r /= samples; g /= samples; b /= samples;
+            size_t i = static_cast<size_t>(cy) * chromaWidth + cx;
+            uPlane[i] = static_cast<uint8_t>(std::clamp(((-43 * r - 85 * g + 128 * b) >> 8) + 128, 0, 255));
+            vPlane[i] = static_cast<uint8_t>(std::clamp(((128 * r - 107 * g - 21 * b) >> 8) + 128, 0, 255));
+        }
+    }
+
+    stream << "FRAME\n";
+    stream.write(reinterpret_cast<const char*>(encodeBuffer.data()), encodeBuffer.size());
+}
+
+void FrameCapture::writePngFrame(const FrameBuffer& frame) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%06llu.png", static_cast<unsigned long long>(frame.frameNumber));
+    std::ofstream file(outputPath + suffix, std::ios::binary | std::ios::trunc);
+    if (!file) return;
+
+    // Uncompressed (stored) deflate keeps encoding cheap; the frames are meant for
+    // post-processing, where a real encoder can recompress them
+    std::vector<uint8_t>& out = encodeBuffer;
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(signature, signature + 8);
+
+    size_t chunk = beginPngChunk(out, "IHDR");
+    appendBigEndian32(out, static_cast<uint32_t>(width));
+    appendBigEndian32(out, static_cast<uint32_t>(height));
+    out.push_back(8);  // Bit depth
+    out.push_back(6);  // Colour type: RGBA
+    out.push_back(0);  // Compression
+    out.push_back(0);  // Filter
+    out.push_back(0);  // Interlace
+    finishPngChunk(out, chunk);
+
+    chunk = beginPngChunk(out, "IDAT");
+    out.push_back(0x78); // zlib header: deflate, 32K window, no preset dictionary
+    out.push_back(0x01);
+
+    // Raw scanlines, each prefixed with filter type 0 (none)
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    scanlineBuffer.resize((rowBytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        uint8_t* dst = &scanlineBuffer[y * (rowBytes + 1)];
+        dst[0] = 0;
+        std::copy_n(frame.pixels.data() + y * rowBytes, rowBytes, dst + 1);
+    }
+
+    // Split into stored deflate blocks of at most 65535 bytes
+    size_t offset = 0;
+    while (offset < scanlineBuffer.size()) {
+        size_t blockSize = std::min<size_t>(scanlineBuffer.size() - offset, 65535);
+        bool last = offset + blockSize == scanlineBuffer.size();
+        out.push_back(last ? 1 : 0);
+        out.push_back(static_cast<uint8_t>(blockSize));
+        out.push_back(static_cast<uint8_t>(blockSize >> 8));
+        out.push_back(static_cast<uint8_t>(~blockSize));
+        out.push_back(static_cast<uint8_t>(~blockSize >> 8));
+        out.insert(out.end(), scanlineBuffer.begin() + offset, scanlineBuffer.begin() + offset + blockSize);
+        offset += blockSize;
+    }
+
+    // Adler-32 of the uncompressed data, reducing only every 5552 bytes as zlib does
+    uint32_t adlerA = 1, adlerB = 0;
+    for (size_t i = 0; i < scanlineBuffer.size();) {
+        size_t end = std::min(scanlineBuffer.size(), i + 5552);
+        for (; i < end; i++) {
+            adlerA += scanlineBuffer[i];
+            adlerB += adlerA;
+        }
+        adlerA %= 65521;
+        adlerB %= 65521;
+    }
+    appendBigEndian32(out, (adlerB << 16) | adlerA);
+    finishPngChunk(out, chunk);
+
+    chunk = beginPngChunk(out, "IEND");
+    finishPngChunk(out, chunk);
+
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+}
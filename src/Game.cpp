@@ -3,26 +3,44 @@
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <thread>
+#include <random>
+#include <cstring>
+#include <algorithm>
+
+// Stereo position for a sound emitted at horizontal position x
+static float panForX(double x, int arenaWidth) {
+    return static_cast<float>(x / arenaWidth * 2.0 - 1.0);
+}
+
+static uint64_t seedFor(const GameOptions& options) {
+    if (options.seed != 0) return options.seed;
+    return std::random_device()() | (static_cast<uint64_t>(std::random_device()()) << 32);
+}
 
-Game::Game()
-    : window(nullptr), renderer(nullptr), font(nullptr), smallFont(nullptr),
-      leftPaddle(Constants::LEFT_PADDLE_START_X, Constants::PADDLE_START_Y, 
-                 Constants::PADDLE_WIDTH, Constants::PADDLE_HEIGHT, Constants::PADDLE_SPEED),
-      rightPaddle(Constants::RIGHT_PADDLE_START_X, Constants::PADDLE_START_Y, 
-                  Constants::PADDLE_WIDTH, Constants::PADDLE_HEIGHT, Constants::PADDLE_SPEED),
-      player1Score(0), player2Score(0), winner(0), gameRunning(true), gameOver(false),
-      wPressed(false), sPressed(false), upPressed(false), downPressed(false),
-      roundInProgress(false), scoreThisRound(false), currentFPS(0.0),
-      lastPlayerToHit(0), player1ControlsInverted(false), player2ControlsInverted(false),
-      gen(rd()), powerUpSpawnDis(0.0, 1.0), powerUpPositionDis(0.0, 1.0) {
+Game::Game(const GameOptions& options)
+    : options(options), window(nullptr), renderer(nullptr),
+      match(options.rules, seedFor(options)), arena(match.getArena()),
+      camera(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT),
+      particles(match.getRng().effects),
+      gameRunning(true), wPressed(false), sPressed(false), upPressed(false), downPressed(false),
+      vsyncActive(false), windowVisible(true), needsRedraw(false),
+      dirtyRects(false), dirty(Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT),
+      lastView{0.0f, 0.0f, 0.0f, 0.0f}, lastPaddleAreas{},
+      quality(Constants::FRAME_DURATION_US / 1e6), firstFramePresented(false),
+      currentFPS(0.0), framesSinceFpsText(THROTTLED_FPS_TEXT_FRAMES) {
     
     lastFrameTime = std::chrono::high_resolution_clock::now();
-    lastPowerUpSpawn = std::chrono::high_resolution_clock::now();
-    
-    // Start with one ball
-    balls.emplace_back(Constants::WINDOW_WIDTH / 2, Constants::WINDOW_HEIGHT / 2, Constants::BALL_SIZE);
-    balls[0].serve();
-    roundInProgress = true;
+    camera.reset(arena);
+    match.setListener(this);
+    if (options.qualityLevel >= 0) {
+        quality.pin(static_cast<QualityLevel>(options.qualityLevel));
+    }
+    if (options.scenario) {
+        scenarioRng.reseed(match.getSeed(), Scenario::PLACEMENT_STREAM);
+        options.scenario->populate(match, options.scenarioBalls, scenarioRng);
+        stressFrames.reserve(options.scenario->ticks);
+    }
 }
 
 Game::~Game() {
@@ -30,13 +48,15 @@ Game::~Game() {
 }
 
 bool Game::initialize() {
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
+    startupBegin = std::chrono::high_resolution_clock::now();
+    std::cout << "Match seed: " << match.getSeed() << std::endl;
+    
+    if (options.offscreen) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
     }
     
-    if (!TTF_Init()) {
-        std::cerr << "SDL_ttf could not initialize! SDL_ttf Error: " << SDL_GetError() << std::endl;
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
     
@@ -47,293 +67,528 @@ bool Game::initialize() {
         std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    windowCreated = std::chrono::high_resolution_clock::now();
     
-    renderer = SDL_CreateRenderer(window, nullptr);
+    renderer = SDL_CreateRenderer(window, options.offscreen ? "software" : nullptr);
     if (!renderer) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
     
-    // Load fonts with proper fallbacks for each platform
-    const char* fontPaths[] = {
-#ifdef __APPLE__
-        "/System/Library/Fonts/Geneva.ttf",
-        "/System/Library/Fonts/Monaco.ttf", 
-        "/System/Library/Fonts/SFCompact.ttf",
-        "/System/Library/Fonts/ArialHB.ttc",
-#elif __linux__
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-        "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
-        "/usr/share/fonts/TTF/arial.ttf",
-#elif _WIN32
-        "C:\\Windows\\Fonts\\arial.ttf",
-        "C:\\Windows\\Fonts\\calibri.ttf",
-        "C:\\Windows\\Fonts\\tahoma.ttf",
-#endif
-        nullptr
-    };
-    
-    // Try to load the main font
-    for (int i = 0; fontPaths[i] != nullptr; i++) {
-        font = TTF_OpenFont(fontPaths[i], 36);
-        if (font) {
-            break;
+    // The software renderer uploads and presents the whole window every frame. Drawing
+    // into the window surface directly lets a frame push only the rects that changed.
+    if (options.dirtyRects && std::string(SDL_GetRendererName(renderer)) == "software") {
+        SDL_DestroyRenderer(renderer);
+        SDL_Surface* surface = SDL_GetWindowSurface(window);
+        renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+        dirtyRects = renderer != nullptr;
+        if (!renderer) {
+            std::cerr << "Window surface unavailable, redrawing full frames. SDL_Error: " << SDL_GetError() << std::endl;
+            renderer = SDL_CreateRenderer(window, "software");
+            if (!renderer) {
+                std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    if (options.vsync) {
+        vsyncActive = SDL_SetRenderVSync(renderer, 1);
+        if (!vsyncActive) {
+            std::cerr << "VSync unavailable, falling back to timed frame pacing. SDL_Error: " << SDL_GetError() << std::endl;
         }
     }
     
-    if (!font) {
-        std::cerr << "Failed to load any font! Tried all system font paths." << std::endl;
-        std::cerr << "SDL_ttf Error: " << SDL_GetError() << std::endl;
+    if (!options.capturePath.empty()) {
+        if (!capture.start(options.capturePath, options.captureFormat,
+                           Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, Constants::FPS)) {
+            return false;
+        }
+    }
+    
+    if (options.metricsPort > 0 && !metrics.startServer(options.metricsPort)) {
         return false;
     }
     
-    // Load small font
-    for (int i = 0; fontPaths[i] != nullptr; i++) {
-        smallFont = TTF_OpenFont(fontPaths[i], 12);
-        if (smallFont) break;
+    if (!options.telemetryPath.empty()) {
+        if (!telemetry.start(options.telemetryPath)) {
+            return false;
+        }
+        telemetry.emit(TelemetryEventType::MATCH_START, match.getElapsedTicks(), 0, 0, 0.0f, 0.0f);
     }
     
+    // Never fails: without a usable system font, text falls back to a built-in bitmap font
+    text.initialize(renderer);
+    
     return true;
 }
 
 void Game::run() {
+    auto frameDuration = std::chrono::microseconds(Constants::FRAME_DURATION_US);
+    auto nextFrameTime = std::chrono::high_resolution_clock::now();
+    
     while (gameRunning) {
+        if (isIdle()) {
+            // Nothing changes on screen until an event arrives, so block instead of polling
+            waitForEvents();
+            if (needsRedraw && windowVisible) {
+                render();
+                needsRedraw = false;
+            }
+            // Resume on a fresh schedule rather than trying to catch up missed frames
+            nextFrameTime = std::chrono::high_resolution_clock::now();
+            lastFrameTime = nextFrameTime;
+            continue;
+        }
+        
         auto currentTime = std::chrono::high_resolution_clock::now();
-        auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastFrameTime);
+        bool missedDeadline = currentTime - lastFrameTime > frameDuration * 3 / 2;
+        handleEvents();
+        auto simulateStart = std::chrono::high_resolution_clock::now();
+        if (!match.isOver()) {
+            update();
+        }
+        auto renderStart = std::chrono::high_resolution_clock::now();
+        render();
+        updateFPS();
+        lastFrameTime = currentTime;
         
-        if (deltaTime.count() >= Constants::FRAME_DELAY) {
-            handleEvents();
-            if (!gameOver) {
-                update();
+        if (options.scenario) {
+            std::chrono::duration<double> simulate = renderStart - simulateStart, draw = presentStart - renderStart;
+            int entities = static_cast<int>(match.getBalls().size() + match.getPowerUps().size()) + particles.getLiveCount();
+            stressFrames.push_back({simulate.count(), draw.count(), entities});
+            if (stressFrames.size() >= static_cast<size_t>(options.scenario->ticks)) {
+                gameRunning = false;
             }
-            render();
-            updateFPS();
-            lastFrameTime = currentTime;
         }
         
-        SDL_Delay(1); // Small delay to prevent excessive CPU usage
+        // Presents may block on the display, so only the drawing work counts against the budget
+        std::chrono::duration<double> drawWork = presentStart - currentTime;
+        if (quality.recordFrame(drawWork.count())) {
+            dirty.markAll();
+            metrics.recordQuality(static_cast<int>(quality.getLevel()));
+            std::cout << "Render quality level " << static_cast<int>(quality.getLevel()) << std::endl;
+        }
+        
+        std::chrono::duration<double> workTime = std::chrono::high_resolution_clock::now() - currentTime;
+        metrics.recordFrame(workTime.count(), missedDeadline);
+        
+        // Presents already block on the display when vsync is active
+        if (vsyncActive) {
+            continue;
+        }
+        
+        nextFrameTime += frameDuration;
+        auto now = std::chrono::high_resolution_clock::now();
+        if (nextFrameTime < now - frameDuration) {
+            // Fell more than a frame behind (e.g. window drag); don't burst to catch up
+            nextFrameTime = now;
+        }
+        sleepUntil(nextFrameTime);
+    }
+    
+    if (options.rules.fixedPoint) {
+        std::cout << "State hash at tick " << match.getElapsedTicks() << ": " << std::hex << std::setw(16) << std::setfill('0')
+                  << match.computeStateHash() << std::dec << std::setfill(' ') << std::endl;
+    }
+}
+
+void Game::finishStartup() {
+    auto now = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> toWindow = windowCreated - startupBegin;
+    std::chrono::duration<double, std::milli> toFirstFrame = now - windowCreated;
+    std::cout << "Startup: window after " << std::fixed << std::setprecision(1) << toWindow.count()
+              << " ms, first frame " << toFirstFrame.count() << " ms later" << std::endl;
+    metrics.recordStartup(toWindow.count() / 1000.0, toFirstFrame.count() / 1000.0);
+    
+    // Work that doesn't need to delay the first frame. Sound is optional; the game
+    // runs silently if no device can be opened
+    if (!options.mute) {
+        audio.initialize();
+    }
+    text.startGlyphWarmup();
+}
+
+bool Game::isIdle() const {
+    // Recordings need a steady frame rate, so capture keeps the loop running
+    if (capture.isActive()) return false;
+    return match.isOver() || !windowVisible;
+}
+
+void Game::waitForEvents() {
+    SDL_Event e;
+    if (!SDL_WaitEvent(&e)) {
+        return;
+    }
+    processEvent(e);
+    
+    // Drain anything else that queued up with it
+    while (SDL_PollEvent(&e)) {
+        processEvent(e);
+    }
+}
+
+void Game::sleepUntil(std::chrono::high_resolution_clock::time_point deadline) {
+    auto spinWindow = std::chrono::microseconds(Constants::FRAME_SPIN_US);
+    
+    // Sleep through most of the wait; the OS scheduler may overshoot by a fraction of a millisecond
+    auto remaining = deadline - std::chrono::high_resolution_clock::now();
+    if (remaining > spinWindow) {
+        auto sleepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - spinWindow);
+        SDL_DelayNS(static_cast<Uint64>(sleepTime.count()));
+    }
+    
+    // Spin only for the final stretch so the frame starts on time
+    while (std::chrono::high_resolution_clock::now() < deadline) {
+        std::this_thread::yield();
     }
 }
 
 void Game::cleanup() {
-    if (font) TTF_CloseFont(font);
-    if (smallFont) TTF_CloseFont(smallFont);
+    capture.stop();
+    telemetry.stop();
+    metrics.stopServer();
+    audio.shutdown();
+    text.shutdown();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
-    TTF_Quit();
+    renderer = nullptr;
+    window = nullptr;
     SDL_Quit();
 }
 
 void Game::handleEvents() {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_EVENT_QUIT) {
+        processEvent(e);
+    }
+}
+
+void Game::processEvent(const SDL_Event& e) {
+    switch (e.type) {
+        case SDL_EVENT_QUIT:
             gameRunning = false;
-        } else if (e.type == SDL_EVENT_KEY_DOWN) {
+            break;
+        case SDL_EVENT_WINDOW_HIDDEN:
+        case SDL_EVENT_WINDOW_MINIMIZED:
+        case SDL_EVENT_WINDOW_OCCLUDED:
+            windowVisible = false;
+            break;
+        case SDL_EVENT_WINDOW_SHOWN:
+        case SDL_EVENT_WINDOW_RESTORED:
+        case SDL_EVENT_WINDOW_EXPOSED:
+            windowVisible = true;
+            needsRedraw = true;
+            dirty.markAll();
+            break;
+        case SDL_EVENT_KEY_DOWN:
             switch (e.key.key) {
                 case SDLK_W: wPressed = true; break;
                 case SDLK_S: sPressed = true; break;
                 case SDLK_UP: upPressed = true; break;
                 case SDLK_DOWN: downPressed = true; break;
-                case SDLK_R: if (gameOver) resetGame(); break;
+                case SDLK_R: if (match.isOver()) resetGame(); break;
+                case SDLK_EQUALS: camera.zoomBy(1.25f, arena); needsRedraw = true; break;
+                case SDLK_MINUS: camera.zoomBy(0.8f, arena); needsRedraw = true; break;
+                case SDLK_0: camera.reset(arena); needsRedraw = true; break;
                 case SDLK_ESCAPE: gameRunning = false; break;
             }
-        } else if (e.type == SDL_EVENT_KEY_UP) {
+            break;
+        case SDL_EVENT_KEY_UP:
             switch (e.key.key) {
                 case SDLK_W: wPressed = false; break;
                 case SDLK_S: sPressed = false; break;
                 case SDLK_UP: upPressed = false; break;
                 case SDLK_DOWN: downPressed = false; break;
             }
-        }
+            break;
     }
 }
 
 void Game::update() {
-    updatePaddles();
-    updateBalls();
-    updatePowerUps();
-    updateControlInversion();
-    spawnPowerUp();
-    checkCollisions();
-    checkPowerUpCollisions();
-    checkScore();
-}
-
-void Game::updateBalls() {
-    // Move all balls and remove those that are off-screen
-    auto it = balls.begin();
-    while (it != balls.end()) {
-        it->move();
-        // Check if ball is completely off screen
-        if (it->position.x < -it->width - 50 || it->position.x > Constants::WINDOW_WIDTH + 50) {
-            it = balls.erase(it);
+    // Age existing particles first so effects spawned during the tick are drawn fresh
+    particles.update();
+    match.tick({wPressed, sPressed}, {upPressed, downPressed});
+    if (options.scenario) {
+        options.scenario->populate(match, options.scenarioBalls, scenarioRng);
+    }
+    updateParticles();
+    camera.follow(match.getBalls(), arena);
+    
+    // Logged on the match's monotonic tick, which a rewind doesn't wind back
+    uint32_t tickCount = match.getElapsedTicks();
+    if (options.rules.fixedPoint && tickCount % STATE_HASH_INTERVAL == 0 && telemetry.isActive()) {
+        // The hash's raw bits ride in the two position floats
+        uint64_t hash = match.computeStateHash();
+        uint32_t low = static_cast<uint32_t>(hash), high = static_cast<uint32_t>(hash >> 32);
+        float lowBits, highBits;
+        std::memcpy(&lowBits, &low, sizeof(lowBits));
+        std::memcpy(&highBits, &high, sizeof(highBits));
+        telemetry.emit(TelemetryEventType::STATE_HASH, tickCount, 0, 0, lowBits, highBits);
+    }
+    
+    metrics.recordTick(static_cast<int>(match.getBalls().size()), static_cast<int>(match.getPowerUps().size()),
+                       particles.getLiveCount(), match.getCollisionChecks());
+}
+
+void Game::updateParticles() {
+    // Ball trails and a slow swirl around the gravity well
+    for (const auto& ball : match.getBalls()) {
+        particles.emitTrail(static_cast<float>(ball.position.x + ball.width / 2.0),
+                            static_cast<float>(ball.getCenterY()),
+                            static_cast<float>(ball.velocity.x), static_cast<float>(ball.velocity.y));
+    }
+    if (options.rules.gravity) {
+        particles.emitSwirl(static_cast<float>(arena.centerX()), static_cast<float>(arena.centerY()),
+                            static_cast<float>(Constants::GRAVITY_RADIUS), 2);
+    }
+}
+
+void Game::render() {
+    const std::vector<Ball>& balls = match.getBalls();
+    ballGrid.build(balls, arena);
+    visibleBalls.clear();
+    ballGrid.query(camera.getViewRect(), visibleBalls);
+    
+    bool fpsTextChanged = refreshFpsText();
+    // Independent of which regions get redrawn, so the cache fills even while the score is idle
+    text.warmGlyphs();
+    
+    const std::vector<SDL_Rect>* presentRects = nullptr;
+    if (dirtyRects) {
+        // Clear and redraw each changed region with drawing clipped to it; the rest of
+        // the surface still holds the previous frame
+        markDirty(fpsTextChanged);
+        presentRects = &dirty.collect();
+        particles.prepareDraw(camera, &dirty, presentRects->size());
+        for (size_t index = 0; index < presentRects->size(); index++) {
+            const SDL_Rect& region = (*presentRects)[index];
+            SDL_SetRenderClipRect(renderer, &region);
+            camera.setClip(&region);
+            SDL_FRect area = {static_cast<float>(region.x), static_cast<float>(region.y),
+                              static_cast<float>(region.w), static_cast<float>(region.h)};
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black
+            SDL_RenderFillRect(renderer, &area);
+            // With the camera clipped, the view rect is this region in world units
+            regionBalls.clear();
+            ballGrid.query(camera.getViewRect(), regionBalls);
+            drawScene(region, index, regionBalls);
+        }
+        SDL_SetRenderClipRect(renderer, nullptr);
+        camera.setClip(nullptr);
+        metrics.recordRedraw(dirty.getCoverage());
+    } else {
+        // Clear screen
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black
+        SDL_RenderClear(renderer);
+        particles.prepareDraw(camera, nullptr, 1);
+        drawScene({0, 0, Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT}, 0, visibleBalls);
+    }
+    
+    if (capture.isActive()) {
+        if (dirtyRects) {
+            // The frame is already in the window surface; copy it without a read-back
+            SDL_FlushRenderer(renderer);
+            capture.captureSurface(SDL_GetWindowSurface(window));
         } else {
-            ++it;
+            capture.captureFrame(renderer);
         }
+        if (options.captureFrameLimit > 0 &&
+            capture.getCapturedFrames() >= static_cast<uint64_t>(options.captureFrameLimit)) {
+            gameRunning = false;
+        }
+    }
+    
+    presentStart = std::chrono::high_resolution_clock::now();
+    if (presentRects) {
+        SDL_FlushRenderer(renderer);
+        SDL_UpdateWindowSurfaceRects(window, presentRects->data(), static_cast<int>(presentRects->size()));
+    } else {
+        SDL_RenderPresent(renderer);
     }
     
-    // If no balls remain, the round is over
-    if (balls.empty()) {
-        roundInProgress = false;
-        scoreThisRound = false;
+    if (!firstFramePresented) {
+        firstFramePresented = true;
+        finishStartup();
     }
 }
 
-void Game::updatePowerUps() {
-    // Remove expired power-ups
-    auto it = powerUps.begin();
-    while (it != powerUps.end()) {
-        if ((*it)->isExpired() || !(*it)->active) {
-            it = powerUps.erase(it);
-        } else {
-            ++it;
+// Screen areas the HUD text can cover, generous enough for either font
+static const SDL_Rect SCORE_TEXT_AREA = {0, 40, Constants::WINDOW_WIDTH, 60};
+static const SDL_Rect FPS_TEXT_AREA = {0, Constants::WINDOW_HEIGHT - 24, 200, 24};
+static const SDL_Rect HINT_TEXT_AREA = {0, 16, Constants::WINDOW_WIDTH, 44};
+static const SDL_Rect GAME_OVER_TEXT_AREA = {0, Constants::WINDOW_HEIGHT / 2 - 20, Constants::WINDOW_WIDTH, 72};
+
+void Game::markDirty(bool fpsTextChanged) {
+    // A moving camera shifts everything, and score changes also swap the hint text and
+    // the game-over overlay in or out, so those repaint the whole window
+    SDL_FRect view = camera.getViewRect();
+    if (view.x != lastView.x || view.y != lastView.y || view.w != lastView.w || view.h != lastView.h) {
+        dirty.markAll();
+        lastView = view;
+    }
+    std::string scoreText = getScoreText();
+    if (scoreText != lastScoreText || match.isOver()) {
+        dirty.markAll();
+        lastScoreText = scoreText;
+    }
+    
+    // Regions drawn last frame are repainted too (DirtyRegion keeps them), which erases
+    // whatever moved away. Paddles often sit still, so they mark their old spot themselves.
+    const Paddle* paddles[2] = {&match.getLeftPaddle(), &match.getRightPaddle()};
+    for (int i = 0; i < 2; i++) {
+        SDL_FRect area = camera.toScreen(paddles[i]->position.x, paddles[i]->position.y,
+                                         paddles[i]->width, paddles[i]->height);
+        if (area.x != lastPaddleAreas[i].x || area.y != lastPaddleAreas[i].y) {
+            dirty.mark(lastPaddleAreas[i]);
+            dirty.mark(area);
+            lastPaddleAreas[i] = area;
         }
     }
+    
+    const std::vector<Ball>& balls = match.getBalls();
+    for (int index : visibleBalls) {
+        const Ball& ball = balls[index];
+        dirty.mark(camera.toScreen(ball.position.x, ball.position.y, ball.width, ball.height));
+    }
+    for (const auto& powerUp : match.getPowerUps()) {
+        dirty.mark(camera.toScreen(powerUp->position.x, powerUp->position.y, powerUp->width, powerUp->height));
+    }
+    particles.markDirty(dirty, camera);
+    
+    if (fpsTextChanged) {
+        SDL_FRect fpsArea = {static_cast<float>(FPS_TEXT_AREA.x), static_cast<float>(FPS_TEXT_AREA.y),
+                             static_cast<float>(FPS_TEXT_AREA.w), static_cast<float>(FPS_TEXT_AREA.h)};
+        dirty.mark(fpsArea);
+    }
 }
 
-void Game::render() {
-    // Clear screen
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black
-    SDL_RenderClear(renderer);
-    
-    // Draw game elements
+void Game::drawScene(const SDL_Rect& area, size_t areaIndex, const std::vector<int>& ballIndices) {
+    // Draw game elements; only what the camera can see is submitted. While the camera
+    // is clipped to a dirty region, isVisible tests against that region alone.
     drawField();
     drawGravityWell();
-    leftPaddle.draw(renderer);
-    rightPaddle.draw(renderer);
-    for (const auto& ball : balls) {
-        ball.draw(renderer);
+    particles.draw(renderer, areaIndex);
+    for (const Paddle* paddle : {&match.getLeftPaddle(), &match.getRightPaddle()}) {
+        if (camera.isVisible(paddle->position.x, paddle->position.y, paddle->width, paddle->height)) {
+            paddle->draw(renderer, camera);
+        }
+    }
+    
+    const std::vector<Ball>& balls = match.getBalls();
+    for (int index : ballIndices) {
+        const Ball& ball = balls[index];
+        if (!camera.isVisible(ball.position.x, ball.position.y, ball.width, ball.height)) continue;
+        if (quality.roundBalls()) {
+            ball.draw(renderer, camera);
+        } else {
+            ball.drawQuad(renderer, camera);
+        }
     }
     
     // Draw power-ups
-    for (const auto& powerUp : powerUps) {
-        powerUp->draw(renderer);
+    for (const auto& powerUp : match.getPowerUps()) {
+        if (camera.isVisible(powerUp->position.x, powerUp->position.y, powerUp->width, powerUp->height)) {
+            powerUp->draw(renderer, match.getTickCount(), camera, quality.animatePowerUps());
+        }
     }
     
-    drawScore();
-    drawFPS();
+    // Text is the costliest thing to draw, so skip it in regions it can't reach
+    if (SDL_HasRectIntersection(&area, &SCORE_TEXT_AREA)) {
+        drawScore();
+    }
+    if (SDL_HasRectIntersection(&area, &FPS_TEXT_AREA)) {
+        drawFPS();
+    }
     
-    if (gameOver) {
-        drawGameOver();
-    } else if (player1Score == 0 && player2Score == 0) {
+    if (match.isOver()) {
+        drawGameOver(area);
+    } else if (match.getPlayer1Score() == 0 && match.getPlayer2Score() == 0 &&
+               SDL_HasRectIntersection(&area, &HINT_TEXT_AREA)) {
         drawControlsHint();
     }
-    
-    SDL_RenderPresent(renderer);
 }
 
-void Game::updatePaddles() {
-    // Handle player 1 controls (swap W/S inputs when controls are inverted)
-    bool moveUp1 = player1ControlsInverted ? sPressed : wPressed;
-    bool moveDown1 = player1ControlsInverted ? wPressed : sPressed;
-    
-    if (moveUp1) leftPaddle.moveUp();
-    if (moveDown1) leftPaddle.moveDown();
-    
-    // Handle player 2 controls (swap UP/DOWN inputs when controls are inverted)
-    bool moveUp2 = player2ControlsInverted ? downPressed : upPressed;
-    bool moveDown2 = player2ControlsInverted ? upPressed : downPressed;
+void Game::resetGame() {
+    match.reset();
+    telemetry.emit(TelemetryEventType::MATCH_START, match.getElapsedTicks(), 0, 0, 0.0f, 0.0f);
+}
+
+void Game::onPaddleHit(const Ball& ball, int player, double impactPoint) {
+    // Sparks fly off the paddle face in the ball's new direction
+    SDL_Color sparkColor = {255, 230, 120, 255};
+    particles.emitSparks(static_cast<float>(player == 1 ? ball.position.x : ball.position.x + ball.width),
+                         static_cast<float>(ball.getCenterY()), static_cast<float>(ball.getVelX()), 24, sparkColor);
     
-    if (moveUp2) rightPaddle.moveUp();
-    if (moveDown2) rightPaddle.moveDown();
+    audio.play(SoundEffect::PADDLE_HIT, 1.0f, panForX(ball.position.x, arena.width));
+    telemetry.emit(TelemetryEventType::PADDLE_HIT, match.getElapsedTicks(), static_cast<uint8_t>(player), 0,
+                   static_cast<float>(ball.position.x), static_cast<float>(ball.getCenterY()),
+                   static_cast<float>(impactPoint), static_cast<float>(ball.velocity.magnitude()));
 }
 
-void Game::checkCollisions() {
-    for (auto& ball : balls) {
-        // Ball with top and bottom walls
-        if (ball.position.y <= 0 || ball.position.y >= Constants::WINDOW_HEIGHT - ball.height) {
-            ball.reverseY();
-            ball.position.y = std::max(0.0, std::min(static_cast<double>(Constants::WINDOW_HEIGHT - ball.height), ball.position.y));
-        }
-        
-        // Ball with paddles
-        if (ball.intersects(leftPaddle) && ball.getVelX() < 0) {
-            handlePaddleCollision(ball, leftPaddle);
-        } else if (ball.intersects(rightPaddle) && ball.getVelX() > 0) {
-            handlePaddleCollision(ball, rightPaddle);
-        }
-    }
+void Game::onWallBounce(const Ball& ball) {
+    audio.play(SoundEffect::WALL_BOUNCE, 0.6f, panForX(ball.position.x, arena.width));
+    telemetry.emit(TelemetryEventType::WALL_BOUNCE, match.getElapsedTicks(), 0, ball.position.y > 0 ? 1 : 0,
+                   static_cast<float>(ball.position.x), static_cast<float>(ball.position.y),
+                   static_cast<float>(ball.velocity.x), static_cast<float>(ball.velocity.y));
 }
 
-void Game::handlePaddleCollision(Ball& ball, Paddle& paddle) {
-    ball.reverseX();
-    
-    // Track which player hit the ball
-    if (&paddle == &leftPaddle) {
-        ball.position.x = paddle.position.x + paddle.width;
-        lastPlayerToHit = 1;
-    } else {
-        ball.position.x = paddle.position.x - ball.width;
-        lastPlayerToHit = 2;
-    }
-    
-    double impactPoint = (ball.getCenterY() - paddle.getCenterY()) / (paddle.height / 2.0);
-    ball.setVelY(ball.getVelY() + impactPoint * 2.0);
-    
-    // Limit the speed of just this ball
-    double maxSpeed = Constants::BALL_SPEED * 1.5;
-    if (std::abs(ball.getVelY()) > maxSpeed) {
-        ball.setVelY(ball.getVelY() > 0 ? maxSpeed : -maxSpeed);
-    }
+void Game::onBallCollision(float x, float y, double closingSpeed) {
+    audio.play(SoundEffect::WALL_BOUNCE, 0.4f, panForX(x, arena.width));
+    telemetry.emit(TelemetryEventType::BALL_COLLISION, match.getElapsedTicks(), 0, 0, x, y,
+                   static_cast<float>(closingSpeed));
+}
+
+void Game::onPowerUpSpawn(const PowerUp& powerUp) {
+    telemetry.emit(TelemetryEventType::POWERUP_SPAWN, match.getElapsedTicks(), 0, static_cast<uint8_t>(powerUp.type),
+                   static_cast<float>(powerUp.position.x), static_cast<float>(powerUp.position.y));
 }
 
+void Game::onPowerUpPickup(const PowerUp& powerUp, int player) {
+    SDL_Color burstColor = powerUp.type == PowerUpType::MULTIBALL ? SDL_Color{255, 215, 0, 255}
+                         : powerUp.type == PowerUpType::REWIND ? SDL_Color{0, 200, 255, 255}
+                         : SDL_Color{255, 0, 0, 255};
+    particles.emitBurst(static_cast<float>(powerUp.position.x + powerUp.width / 2.0),
+                        static_cast<float>(powerUp.position.y + powerUp.height / 2.0),
+                        80, 4.0f, 40.0f, burstColor);
+    audio.play(SoundEffect::POWERUP, 1.0f, panForX(powerUp.position.x, arena.width));
+    telemetry.emit(TelemetryEventType::POWERUP_PICKUP, match.getElapsedTicks(), static_cast<uint8_t>(player),
+                   static_cast<uint8_t>(powerUp.type),
+                   static_cast<float>(powerUp.position.x), static_cast<float>(powerUp.position.y));
+}
 
+void Game::onInversionStart(int player) {
+    telemetry.emit(TelemetryEventType::INVERSION_START, match.getElapsedTicks(), static_cast<uint8_t>(player), 0, 0.0f, 0.0f);
+}
 
-void Game::checkScore() {
-    if (!roundInProgress || scoreThisRound) return; // Already scored this round
-    
-    for (const auto& ball : balls) {
-        if (ball.position.x < 0) {
-            player2Score++;
-            scoreThisRound = true;
-            clearAllBalls();
-            checkWinCondition();
-            serveBall();
-            return;
-        } else if (ball.position.x > Constants::WINDOW_WIDTH) {
-            player1Score++;
-            scoreThisRound = true;
-            clearAllBalls();
-            checkWinCondition();
-            serveBall();
-            return;
-        }
-    }
+void Game::onInversionEnd(int player) {
+    telemetry.emit(TelemetryEventType::INVERSION_END, match.getElapsedTicks(), static_cast<uint8_t>(player), 0, 0.0f, 0.0f);
 }
 
-void Game::checkWinCondition() {
-    if (player1Score >= Constants::WIN_SCORE) {
-        winner = 1;
-        gameOver = true;
-    } else if (player2Score >= Constants::WIN_SCORE) {
-        winner = 2;
-        gameOver = true;
+void Game::onRewind(int player, uint32_t ticks) {
+    // Mark the jump with a ring at every ball's restored position
+    SDL_Color rewindColor = {0, 200, 255, 255};
+    for (const auto& ball : match.getBalls()) {
+        particles.emitBurst(static_cast<float>(ball.position.x + ball.width / 2.0), static_cast<float>(ball.getCenterY()),
+                            30, 3.0f, 30.0f, rewindColor);
     }
+    telemetry.emit(TelemetryEventType::REWIND, match.getElapsedTicks(), static_cast<uint8_t>(player), 0, 0.0f, 0.0f,
+                   static_cast<float>(ticks));
 }
 
-void Game::serveBall() {
-    if (!gameOver) {
-        clearAllBalls();
-        balls.emplace_back(Constants::WINDOW_WIDTH / 2, Constants::WINDOW_HEIGHT / 2, Constants::BALL_SIZE);
-        balls[0].serve();
-        roundInProgress = true;
-        scoreThisRound = false;
-    }
+void Game::onScore(int player, const Ball& ball) {
+    SDL_Color scoreBurstColor = {255, 90, 90, 255};
+    float edgeX = player == 2 ? 0.0f : static_cast<float>(arena.width);
+    particles.emitBurst(edgeX, static_cast<float>(ball.getCenterY()), 150, 6.0f, 45.0f, scoreBurstColor);
+    audio.play(SoundEffect::SCORE, 1.0f, player == 2 ? -0.8f : 0.8f);
+    telemetry.emit(TelemetryEventType::SCORE, match.getElapsedTicks(), static_cast<uint8_t>(player), 0,
+                   static_cast<float>(ball.position.x), static_cast<float>(ball.getCenterY()),
+                   static_cast<float>(match.getPlayer1Score()), static_cast<float>(match.getPlayer2Score()));
 }
 
-void Game::resetGame() {
-    player1Score = 0;
-    player2Score = 0;
-    winner = 0;
-    gameOver = false;
-    
-    // Reset control inversion state when starting a new game
-    player1ControlsInverted = false;
-    player2ControlsInverted = false;
-    controlInversionStart = std::chrono::high_resolution_clock::now();
-    
-    serveBall();
+void Game::onMatchEnd(int winner) {
+    telemetry.emit(TelemetryEventType::MATCH_END, match.getElapsedTicks(), static_cast<uint8_t>(winner), 0, 0.0f, 0.0f,
+                   static_cast<float>(match.getPlayer1Score()), static_cast<float>(match.getPlayer2Score()));
 }
 
 void Game::updateFPS() {
@@ -347,37 +602,51 @@ void Game::updateFPS() {
 void Game::drawField() {
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
     
-    // Draw dashed center line
-    for (int y = 0; y < Constants::WINDOW_HEIGHT; y += 20) {
+    int centerX = arena.width / 2;
+    if (!camera.isVisible(centerX, 0, 1, arena.height)) return;
+    
+    // Draw dashed center line, only the dashes inside the view
+    SDL_FRect view = camera.getViewRect();
+    int firstDash = std::max(0, static_cast<int>(view.y) / 20 * 20);
+    int lastDash = std::min(arena.height, static_cast<int>(view.y + view.h) + 20);
+    for (int y = firstDash; y < lastDash; y += 20) {
         if ((y / 10) % 2 == 0) {
-            SDL_RenderLine(renderer, Constants::WINDOW_WIDTH / 2, y, 
-                             Constants::WINDOW_WIDTH / 2, std::min(y + 10, Constants::WINDOW_HEIGHT));
+            SDL_RenderLine(renderer, camera.toScreenX(centerX), camera.toScreenY(y), 
+                           camera.toScreenX(centerX), camera.toScreenY(std::min(y + 10, arena.height)));
         }
     }
 }
 
 void Game::drawGravityWell() {
-    SDL_SetRenderDrawColor(renderer, 100, 150, 255, 60); // Semi-transparent blue
+    if (!options.rules.gravity) return;
     
-    // Draw gravity well circle outline
-    int centerX = Constants::GRAVITY_CENTER_X;
-    int centerY = Constants::GRAVITY_CENTER_Y;
+    int centerX = static_cast<int>(arena.centerX());
+    int centerY = static_cast<int>(arena.centerY());
     int radius = static_cast<int>(Constants::GRAVITY_RADIUS);
+    if (!camera.isVisible(centerX - radius, centerY - radius, radius * 2, radius * 2)) return;
+    
+    SDL_SetRenderDrawColor(renderer, 100, 150, 255, 60); // Semi-transparent blue
     
-    // Draw circle by drawing points
+    // Draw gravity well circle outline
+
+    // Draw circle by drawing points, skipping those outside the view (or dirty region)
     for (int angle = 0; angle < 360; angle += 2) {
         double radians = angle * M_PI / 180.0;
         int x = centerX + static_cast<int>(radius * std::cos(radians));
         int y = centerY + static_cast<int>(radius * std::sin(radians));
-        SDL_RenderPoint(renderer, x, y);
+        if (!camera.isVisible(x, y, 1, 1)) continue;
+        SDL_RenderPoint(renderer, camera.toScreenX(x), camera.toScreenY(y));
     }
     
     // Draw center indicator
     SDL_SetRenderDrawColor(renderer, 100, 150, 255, 120); // More opaque blue
     int centerSize = 8;
-    SDL_FRect centerRect = {static_cast<float>(centerX - centerSize/2), static_cast<float>(centerY - centerSize/2), 
-                           static_cast<float>(centerSize), static_cast<float>(centerSize)};
-    SDL_RenderFillRect(renderer, &centerRect);
+    if (camera.isVisible(centerX - centerSize/2, centerY - centerSize/2, centerSize, centerSize)) {
+        SDL_FRect centerRect = camera.toScreen(centerX - centerSize/2, centerY - centerSize/2, centerSize, centerSize);
+        SDL_RenderFillRect(renderer, &centerRect);
+    }
+    
+    if (!quality.drawWellLines()) return;
     
     // Draw radial lines
     SDL_SetRenderDrawColor(renderer, 100, 150, 255, 40); // Very transparent blue
@@ -390,174 +659,69 @@ void Game::drawGravityWell() {
         int y1 = centerY + static_cast<int>(std::sin(radians) * innerRadius);
         int x2 = centerX + static_cast<int>(std::cos(radians) * outerRadius);
         int y2 = centerY + static_cast<int>(std::sin(radians) * outerRadius);
+        if (!camera.isVisible(std::min(x1, x2), std::min(y1, y2), std::abs(x2 - x1) + 1, std::abs(y2 - y1) + 1)) continue;
         
-        SDL_RenderLine(renderer, x1, y1, x2, y2);
+        SDL_RenderLine(renderer, camera.toScreenX(x1), camera.toScreenY(y1), camera.toScreenX(x2), camera.toScreenY(y2));
     }
 }
 
+std::string Game::getScoreText() const {
+    return std::to_string(match.getPlayer1Score()) + "  :  " + std::to_string(match.getPlayer2Score());
+}
+
 void Game::drawScore() {
-    std::string scoreText = std::to_string(player1Score) + "  :  " + std::to_string(player2Score);
-    renderTextCentered(scoreText, 50, font);
+    renderTextCentered(getScoreText(), 50, TextSize::LARGE);
 }
 
-void Game::drawFPS() {
-    if (smallFont) {
-        std::stringstream ss;
-        ss << "FPS: " << std::fixed << std::setprecision(1) << currentFPS;
-        renderText(ss.str(), 10, Constants::WINDOW_HEIGHT - 20, smallFont);
+bool Game::refreshFpsText() {
+    // At reduced quality the text is rebuilt a few times a second instead of every frame
+    if (quality.throttleHud() && ++framesSinceFpsText < THROTTLED_FPS_TEXT_FRAMES) {
+        return false;
     }
+    framesSinceFpsText = 0;
+    
+    std::stringstream ss;
+    ss << "FPS: " << std::fixed << std::setprecision(1) << currentFPS;
+    if (ss.str() == fpsText) return false;
+    fpsText = ss.str();
+    return true;
+}
+
+void Game::drawFPS() {
+    renderText(fpsText, 10, Constants::WINDOW_HEIGHT - 20, TextSize::SMALL);
 }
 
-void Game::drawGameOver() {
-    // Draw semi-transparent overlay
+void Game::drawGameOver(const SDL_Rect& area) {
+    // Draw semi-transparent overlay over this region only
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-    SDL_FRect overlay = {0, 0, static_cast<float>(Constants::WINDOW_WIDTH), static_cast<float>(Constants::WINDOW_HEIGHT)};
+    SDL_FRect overlay = {static_cast<float>(area.x), static_cast<float>(area.y),
+                         static_cast<float>(area.w), static_cast<float>(area.h)};
     SDL_RenderFillRect(renderer, &overlay);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     
-    std::string winText = "Player " + std::to_string(winner) + " Wins!";
-    renderTextCentered(winText, Constants::WINDOW_HEIGHT / 2 - 20, font);
+    if (!SDL_HasRectIntersection(&area, &GAME_OVER_TEXT_AREA)) return;
+    
+    std::string winText = "Player " + std::to_string(match.getWinner()) + " Wins!";
+    renderTextCentered(winText, Constants::WINDOW_HEIGHT / 2 - 20, TextSize::LARGE);
     
     std::string restartText = "Press R to restart";
-    renderTextCentered(restartText, Constants::WINDOW_HEIGHT / 2 + 30, smallFont);
+    renderTextCentered(restartText, Constants::WINDOW_HEIGHT / 2 + 30, TextSize::SMALL);
 }
 
 void Game::drawControlsHint() {
-    if (smallFont) {
-        renderText("P1: W/S  |  P2: ↑/↓  |  ESC: Quit", 10, 20, smallFont);
-    }
-}
-
-void Game::renderText(const std::string& text, int x, int y, TTF_Font* fontToUse) {
-    if (!fontToUse) fontToUse = font;
-    if (!fontToUse) return;
-    
-    SDL_Color white = {255, 255, 255, 255};
-    SDL_Surface* textSurface = TTF_RenderText_Solid(fontToUse, text.c_str(), text.length(), white);
-    if (textSurface) {
-        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-        if (textTexture) {
-            SDL_FRect destRect = {static_cast<float>(x), static_cast<float>(y), 
-                                 static_cast<float>(textSurface->w), static_cast<float>(textSurface->h)};
-            SDL_RenderTexture(renderer, textTexture, nullptr, &destRect);
-            SDL_DestroyTexture(textTexture);
-        }
-        SDL_DestroySurface(textSurface);
-    }
-}
-
-void Game::renderTextCentered(const std::string& text, int y, TTF_Font* fontToUse) {
-    if (!fontToUse) fontToUse = font;
-    if (!fontToUse) return;
-    
-    int textWidth, textHeight;
-    if (TTF_GetStringSize(fontToUse, text.c_str(), text.length(), &textWidth, &textHeight)) {
-        int x = (Constants::WINDOW_WIDTH - textWidth) / 2;
-        renderText(text, x, y, fontToUse);
-    }
-}
-
-void Game::spawnPowerUp() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timeSinceLastSpawn = std::chrono::duration_cast<std::chrono::seconds>(currentTime - lastPowerUpSpawn);
-    
-    // Spawn a power-up every 15-25 seconds if none exist
-    if (timeSinceLastSpawn.count() >= 15 && powerUps.empty() && powerUpSpawnDis(gen) < 0.1) {
-        // Spawn in the middle area of the screen, avoiding paddle zones
-        int x = Constants::WINDOW_WIDTH * 0.3 + powerUpPositionDis(gen) * Constants::WINDOW_WIDTH * 0.4;
-        int y = 50 + powerUpPositionDis(gen) * (Constants::WINDOW_HEIGHT - 100);
-        
-        // Randomly choose between MULTIBALL and INVERT_CONTROLS
-        PowerUpType type = (powerUpSpawnDis(gen) < 0.5) ? PowerUpType::MULTIBALL : PowerUpType::INVERT_CONTROLS;
-        
-        powerUps.push_back(std::make_unique<PowerUp>(x, y, type));
-        lastPowerUpSpawn = currentTime;
+    renderText("P1: W/S  |  P2: ↑/↓  |  ESC: Quit", 10, 20, TextSize::SMALL);
+    if (!arena.fitsWindow()) {
+        renderText("+/-: Zoom  |  0: Reset view", 10, 40, TextSize::SMALL);
     }
 }
 
-void Game::checkPowerUpCollisions() {
-    for (auto& powerUp : powerUps) {
-        if (!powerUp->active) continue;
-        
-        for (const auto& ball : balls) {
-            SDL_Rect ballRect = ball.getRect();
-            SDL_Rect powerUpRect = powerUp->getRect();
-            
-            if (SDL_HasRectIntersection(&ballRect, &powerUpRect)) {
-                // Power-up collected!
-                powerUp->active = false;
-                
-                switch (powerUp->type) {
-                    case PowerUpType::MULTIBALL:
-                        activateMultiball();
-                        break;
-                    case PowerUpType::INVERT_CONTROLS:
-                        activateInvertControls();
-                        break;
-                }
-                break; // Only one ball can collect the power-up
-            }
-        }
-    }
-}
-
-void Game::activateInvertControls() {
-    // Apply control inversion to whichever player last hit the ball
-    // This ensures the power-up affects the opponent of whoever collected it
-    if (lastPlayerToHit == 1) {
-        player1ControlsInverted = true;
-        player2ControlsInverted = false;
-    } else if (lastPlayerToHit == 2) {
-        player2ControlsInverted = true;
-        player1ControlsInverted = false;
-    }
-    
-    // Start the inversion timer - effect will last for CONTROL_INVERSION_DURATION seconds
-    controlInversionStart = std::chrono::high_resolution_clock::now();
-}
-
-void Game::updateControlInversion() {
-    // Check if any player currently has inverted controls
-    if (player1ControlsInverted || player2ControlsInverted) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - controlInversionStart);
-        
-        // Disable inversion after the duration expires (10 seconds)
-        if (elapsed.count() >= CONTROL_INVERSION_DURATION) {
-            player1ControlsInverted = false;
-            player2ControlsInverted = false;
-        }
-    }
+void Game::renderText(const std::string& message, int x, int y, TextSize size) {
+    text.draw(message, x, y, size);
 }
 
-void Game::activateMultiball() {
-    if (balls.empty()) return;
-    
-    // Get the current ball's position and velocity
-    Ball& currentBall = balls[0];
-    Vector2 pos = currentBall.position;
-    Vector2 vel = currentBall.velocity;
-    
-    // Clear existing balls
-    balls.clear();
-    
-    // Create 5 balls with different angles
-    double baseAngle = std::atan2(vel.y, vel.x);
-    double speed = vel.magnitude();
-    
-    for (int i = 0; i < 5; i++) {
-        double angle = baseAngle + (i - 2) * 0.3; // Spread balls in a fan pattern
-        
-        Ball newBall(pos.x, pos.y, Constants::BALL_SIZE);
-        newBall.velocity.x = speed * std::cos(angle);
-        newBall.velocity.y = speed * std::sin(angle);
-        
-        balls.push_back(newBall);
-    }
+void Game::renderTextCentered(const std::string& message, int y, TextSize size) {
+    text.drawCentered(message, y, Constants::WINDOW_WIDTH, size);
 }
 
-void Game::clearAllBalls() {
-    balls.clear();
-    powerUps.clear(); // Clear power-ups when round ends
-} 
\ No newline at end of file
+ 
\ No newline at end of file
@@ -0,0 +1,843 @@
+#include "Match.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+// Receives events when no listener is attached
+static MatchListener silentListener;
+
+// Adds the time since the previous lap to one phase; does nothing when timing is off
+class PhaseTimer {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit PhaseTimer(TickPhaseTimes* times)
+        : times(times), start(times ? Clock::now() : Clock::time_point()) {}
+
+    void lap(double TickPhaseTimes::*phase) {
+        if (!times) return;
+        Clock::time_point now = Clock::now();
+        times->*phase += std::chrono::duration<double>(now - start).count();
+        start = now;
+    }
+
+private:
+    TickPhaseTimes* times;
+    Clock::time_point start;
+};
+
+Match::Match(const MatchRules& rules, uint64_t seed)
+    : rules(rules), seed(seed), rng(seed), listener(&silentListener), phaseTimes(nullptr),
+      leftPaddle(rules.arena.leftPaddleX(), rules.arena.paddleStartY(),
+                 Constants::PADDLE_WIDTH, Constants::PADDLE_HEIGHT, Constants::PADDLE_SPEED, rules.arena.height),
+      rightPaddle(rules.arena.rightPaddleX(), rules.arena.paddleStartY(),
+                  Constants::PADDLE_WIDTH, Constants::PADDLE_HEIGHT, Constants::PADDLE_SPEED, rules.arena.height),
+      player1Score(0), player2Score(0), winner(0), gameOver(false),
+      roundInProgress(false), scoreThisRound(false),
+      lastPlayerToHit(0), player1ControlsInverted(false), player2ControlsInverted(false),
+      controlInversionStartTick(0), lastPowerUpSpawnTick(0), tickCount(0), elapsedTicks(0), collisionChecks(0),
+      eventFlight(rules.eventFlight && !rules.ballCollisions), tickFunction(nullptr), rewindPending(false), rewindPlayer(0) {
+    if (rules.rewind) {
+        history = std::make_unique<StateHistory>(HEADER_WORDS + MAX_SNAPSHOT_BALLS * BALL_WORDS +
+                                                 MAX_SNAPSHOT_POWERUPS * POWERUP_WORDS,
+                                                 HISTORY_BYTES, HISTORY_TICKS);
+        snapshot.resize(HEADER_WORDS + MAX_SNAPSHOT_BALLS * BALL_WORDS + MAX_SNAPSHOT_POWERUPS * POWERUP_WORDS);
+    }
+    selectPhysicsProfile();
+    serveBall();
+}
+
+void Match::setListener(MatchListener* matchListener) {
+    listener = matchListener ? matchListener : &silentListener;
+}
+
+void Match::setPhaseTimes(TickPhaseTimes* times) {
+    phaseTimes = times;
+}
+
+void Match::selectPhysicsProfile() {
+    // Every combination of rules is compiled up front; indexed [fixedPoint][gravity][ballCollisions][wrap]
+    static const TickFunction profiles[2][2][2][2] = {
+        {{{&Match::tickWith<PhysicsProfile<false, false, WallMode::BOUNCE, false>>, &Match::tickWith<PhysicsProfile<false, false, WallMode::WRAP, false>>},
+          {&Match::tickWith<PhysicsProfile<false, true, WallMode::BOUNCE, false>>, &Match::tickWith<PhysicsProfile<false, true, WallMode::WRAP, false>>}},
+         {{&Match::tickWith<PhysicsProfile<true, false, WallMode::BOUNCE, false>>, &Match::tickWith<PhysicsProfile<true, false, WallMode::WRAP, false>>},
+          {&Match::tickWith<PhysicsProfile<true, true, WallMode::BOUNCE, false>>, &Match::tickWith<PhysicsProfile<true, true, WallMode::WRAP, false>>}}},
+        {{{&Match::tickWith<PhysicsProfile<false, false, WallMode::BOUNCE, true>>, &Match::tickWith<PhysicsProfile<false, false, WallMode::WRAP, true>>},
+          {&Match::tickWith<PhysicsProfile<false, true, WallMode::BOUNCE, true>>, &Match::tickWith<PhysicsProfile<false, true, WallMode::WRAP, true>>}},
+         {{&Match::tickWith<PhysicsProfile<true, false, WallMode::BOUNCE, true>>, &Match::tickWith<PhysicsProfile<true, false, WallMode::WRAP, true>>},
+          {&Match::tickWith<PhysicsProfile<true, true, WallMode::BOUNCE, true>>, &Match::tickWith<PhysicsProfile<true, true, WallMode::WRAP, true>>}}}
+    };
+    tickFunction = profiles[rules.fixedPoint][rules.gravity][rules.ballCollisions][rules.wallMode == WallMode::WRAP];
+}
+
+void Match::tick(const PaddleInput& left, const PaddleInput& right) {
+    if (gameOver) return;
+    (this->*tickFunction)(left, right);
+}
+
+template<typename Profile>
+void Match::tickWith(const PaddleInput& left, const PaddleInput& right) {
+    PhaseTimer timer(phaseTimes);
+    tickCount++;
+    elapsedTicks++;
+    collisionChecks = 0;
+    updatePaddles(left, right);
+    updateBalls<Profile>();
+    timer.lap(&TickPhaseTimes::movement);
+    updatePowerUps();
+    updateControlInversion();
+    spawnPowerUp();
+    timer.lap(&TickPhaseTimes::powerUps);
+    checkCollisions<Profile>();
+    timer.lap(&TickPhaseTimes::collisions);
+    checkPowerUpCollisions();
+    timer.lap(&TickPhaseTimes::powerUps);
+    checkScore();
+    if (eventFlight) {
+        planFlights<Profile>();
+    }
+    timer.lap(&TickPhaseTimes::collisions);
+
+    if (rewindPending) {
+        rewindPending = false;
+        activateRewind();
+    } else if (history) {
+        captureHistory();
+    }
+    timer.lap(&TickPhaseTimes::history);
+}
+
+void Match::reset() {
+    player1Score = 0;
+    player2Score = 0;
+    winner = 0;
+    gameOver = false;
+
+    // Reset control inversion state when starting a new game; nobody has hit the ball yet,
+    // so the first inversion can't be credited to the last match's hitter
+    player1ControlsInverted = false;
+    player2ControlsInverted = false;
+    controlInversionStartTick = tickCount;
+    lastPlayerToHit = 0;
+    selectPhysicsProfile();
+    if (history) {
+        history->clear();
+    }
+    // A rewind picked up on the last tick of the previous match must not fire in this one
+    rewindPending = false;
+    rewindPlayer = 0;
+
+    serveBall();
+}
+
+template<typename Profile>
+void Match::updateBalls() {
+    // Move all balls and remove those that are off-screen
+    auto it = balls.begin();
+    while (it != balls.end()) {
+        if (it->coastUntil > tickCount) {
+            // Planned straight flight, clear of the well, where the gravity step reduces to
+            // the plain one; fixed point still goes through 16.16 so both paths round alike
+            if constexpr (Profile::fixedPoint) {
+                it->template moveFixed<false>(rules.arena);
+            } else {
+                it->template move<false>(rules.arena);
+            }
+            ++it;
+            continue;
+        }
+        if constexpr (Profile::fixedPoint) {
+            it->template moveFixed<Profile::gravity>(rules.arena);
+        } else {
+            it->template move<Profile::gravity>(rules.arena);
+        }
+        // Check if ball has completely left the arena
+        if (it->position.x < -it->width - 50 || it->position.x > rules.arena.width + 50) {
+            it = balls.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // If no balls remain, the round is over
+    if (balls.empty()) {
+        roundInProgress = false;
+        scoreThisRound = false;
+    }
+}
+
+void Match::updatePowerUps() {
+    // Remove expired power-ups
+    auto it = powerUps.begin();
+    while (it != powerUps.end()) {
+        if ((*it)->isExpired(tickCount) || !(*it)->active) {
+            it = powerUps.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Match::updatePaddles(const PaddleInput& left, const PaddleInput& right) {
+    // Handle player 1 controls (swap up/down inputs when controls are inverted)
+    bool moveUp1 = player1ControlsInverted ? left.down : left.up;
+    bool moveDown1 = player1ControlsInverted ? left.up : left.down;
+
+    if (moveUp1) leftPaddle.moveUp();
+    if (moveDown1) leftPaddle.moveDown();
+
+    // Handle player 2 controls (swap up/down inputs when controls are inverted)
+    bool moveUp2 = player2ControlsInverted ? right.down : right.up;
+    bool moveDown2 = player2ControlsInverted ? right.up : right.down;
+
+    if (moveUp2) rightPaddle.moveUp();
+    if (moveDown2) rightPaddle.moveDown();
+}
+
+template<typename Profile>
+void Match::checkCollisions() {
+    if constexpr (Profile::ballCollisions) {
+        // One test per nearby pair, counted as it runs
+        resolveBallCollisions<Profile::fixedPoint>();
+    }
+
+    // Flag the few balls near a wall or paddle in one batched pass, then run the exact tests
+    // on those alone. Coasting balls were planned clear of every wall and paddle, so event
+    // flight batches only the rest. One wall test and two paddle tests per batched ball.
+    if (eventFlight) {
+        liveBalls.clear();
+        for (size_t i = 0; i < balls.size(); i++) {
+            if (balls[i].coastUntil <= tickCount) {
+                liveBalls.push_back(static_cast<int>(i));
+            }
+        }
+        collisionChecks += static_cast<int>(liveBalls.size()) * 3;
+        contactBatch.build(balls, liveBalls, rules.arena, Profile::walls, leftPaddle, rightPaddle);
+    } else {
+        collisionChecks += static_cast<int>(balls.size()) * 3;
+        contactBatch.build(balls, rules.arena, Profile::walls, leftPaddle, rightPaddle);
+    }
+    for (int index : contactBatch.getCandidates()) {
+        resolveContacts<Profile>(balls[index]);
+    }
+}
+
+template<typename Profile>
+void Match::resolveContacts(Ball& ball) {
+    const Arena& arena = rules.arena;
+    if constexpr (Profile::walls == WallMode::BOUNCE) {
+        // Ball with top and bottom walls
+        if (ball.position.y <= 0 || ball.position.y >= arena.height - ball.height) {
+            ball.reverseY();
+            ball.position.y = std::max(0.0, std::min(static_cast<double>(arena.height - ball.height), ball.position.y));
+            listener->onWallBounce(ball);
+        }
+    } else {
+        // Leave through one edge, come back through the other
+        if (ball.getCenterY() < 0) {
+            ball.position.y += arena.height;
+        } else if (ball.getCenterY() >= arena.height) {
+            ball.position.y -= arena.height;
+        }
+    }
+
+    // Ball with paddles
+    if (ball.intersects(leftPaddle) && ball.getVelX() < 0) {
+        handlePaddleCollision(ball, leftPaddle);
+    } else if (ball.intersects(rightPaddle) && ball.getVelX() > 0) {
+        handlePaddleCollision(ball, rightPaddle);
+    }
+}
+
+template<typename Profile>
+void Match::planFlights() {
+    // Balls whose plan ran out this tick, and any added since, get a new one
+    for (auto& ball : balls) {
+        if (ball.coastUntil > tickCount) continue;
+        double ticks = ticksToContact<Profile>(ball);
+        // A contact reached at time t can first show up at the end of tick ceil(t); coast until then
+        uint32_t coast = ticks >= MAX_COAST_TICKS ? MAX_COAST_TICKS : static_cast<uint32_t>(std::ceil(ticks));
+        ball.coastUntil = tickCount + coast;
+    }
+}
+
+// Ray entry time into [low, high] on one axis, or +inf if never
+static void slab(double position, double velocity, double low, double high, double& enter, double& exit) {
+    if (velocity == 0.0) {
+        bool inside = position >= low && position <= high;
+        enter = inside ? 0.0 : HUGE_VAL;
+        exit = inside ? HUGE_VAL : -HUGE_VAL;
+    } else {
+        double first = (low - position) / velocity, second = (high - position) / velocity;
+        enter = std::max(0.0, std::min(first, second));
+        exit = std::max(first, second);
+    }
+}
+
+template<typename Profile>
+double Match::ticksToContact(const Ball& ball) const {
+    // Time along the straight line until the ball could first touch a wall, a paddle or a
+    // power-up, cross a goal line, or come within a tick's travel of the gravity well.
+    // Every zone is widened by FLIGHT_MARGIN, which easily covers the integer truncation of
+    // rects and the rounding of adding the velocity once per tick.
+    const Arena& arena = rules.arena;
+    double x = ball.position.x, y = ball.position.y;
+    double velX = ball.velocity.x, velY = ball.velocity.y;
+    double time = HUGE_VAL;
+
+    // Walls: bounce tests the top edge, wrap the center
+    double top = FLIGHT_MARGIN, bottom = arena.height - ball.height - FLIGHT_MARGIN;
+    if constexpr (Profile::walls == WallMode::WRAP) {
+        y += ball.height / 2.0;
+        bottom = arena.height - FLIGHT_MARGIN;
+    }
+    if (y <= top || y >= bottom) return 0.0;
+    if (velY < 0.0) time = (y - top) / -velY;
+    if (velY > 0.0) time = (bottom - y) / velY;
+    y = ball.position.y;
+
+    // Paddles and goal lines: the whole region beyond each paddle's inner face, since a
+    // fast ball can pass a paddle column between ticks
+    double leftFace = leftPaddle.position.x + leftPaddle.width + FLIGHT_MARGIN;
+    double rightFace = rightPaddle.position.x - ball.width - FLIGHT_MARGIN;
+    if (x <= leftFace || x >= rightFace) return 0.0;
+    if (velX < 0.0) time = std::min(time, (x - leftFace) / -velX);
+    if (velX > 0.0) time = std::min(time, (rightFace - x) / velX);
+
+    if constexpr (Profile::gravity) {
+        // Ray against the circle where move() would start to substep
+        double speed = ball.velocity.magnitude();
+        double reach = Constants::GRAVITY_RADIUS + speed + FLIGHT_MARGIN;
+        double deltaX = x + ball.width / 2.0 - arena.centerX();
+        double deltaY = y + ball.height / 2.0 - arena.centerY();
+        double outside = deltaX * deltaX + deltaY * deltaY - reach * reach;
+        if (outside <= 0.0) return 0.0;
+        double closing = deltaX * velX + deltaY * velY;
+        double discriminant = closing * closing - speed * speed * outside;
+        if (closing < 0.0 && discriminant >= 0.0) {
+            time = std::min(time, (-closing - std::sqrt(discriminant)) / (speed * speed));
+        }
+    }
+
+    for (const auto& powerUp : powerUps) {
+        if (!powerUp->active) continue;
+        SDL_Rect rect = powerUp->getRect();
+        double enterX, exitX, enterY, exitY;
+        slab(x, velX, rect.x - ball.width - FLIGHT_MARGIN, rect.x + rect.w + FLIGHT_MARGIN, enterX, exitX);
+        slab(y, velY, rect.y - ball.height - FLIGHT_MARGIN, rect.y + rect.h + FLIGHT_MARGIN, enterY, exitY);
+        double enter = std::max(enterX, enterY);
+        if (enter <= std::min(exitX, exitY)) {
+            time = std::min(time, enter);
+        }
+    }
+    return time;
+}
+
+void Match::wakeAllBalls() {
+    // A new power-up may lie across planned flights
+    for (auto& ball : balls) {
+        ball.coastUntil = 0;
+    }
+}
+
+template<bool FixedPoint>
+void Match::resolveBallCollisions() {
+    collisionGrid.build(balls, rules.arena);
+
+    for (size_t i = 0; i < balls.size(); i++) {
+        Ball& first = balls[i];
+        double firstX = first.position.x + first.width / 2.0;
+        double firstY = first.getCenterY();
+
+        // The grid widens queries by a ball size, which covers every ball that can touch this one
+        nearbyBalls.clear();
+        SDL_FRect around = {static_cast<float>(firstX), static_cast<float>(firstY), 0.0f, 0.0f};
+        collisionGrid.query(around, nearbyBalls);
+
+        for (int j : nearbyBalls) {
+            if (j <= static_cast<int>(i)) continue; // Each pair once
+            collisionChecks++;
+
+            Ball& second = balls[j];
+            double deltaX = second.position.x + second.width / 2.0 - firstX;
+            double deltaY = second.getCenterY() - firstY;
+            double minDistance = (first.width + second.width) / 2.0;
+            double distanceSquared = deltaX * deltaX + deltaY * deltaY;
+            if (distanceSquared >= minDistance * minDistance || distanceSquared == 0.0) continue;
+
+            double normalX, normalY, closingSpeed;
+            if constexpr (FixedPoint) {
+                // Same response in 16.16; the overlap test above is exact for on-grid positions
+                using namespace FixedPoint;
+                Fixed fixedDeltaX = fromDouble(deltaX), fixedDeltaY = fromDouble(deltaY);
+                Fixed distance = length(fixedDeltaX, fixedDeltaY);
+                if (distance == 0) continue;
+                Fixed fixedNormalX = divide(fixedDeltaX, distance);
+                Fixed fixedNormalY = divide(fixedDeltaY, distance);
+
+                Fixed push = (fromDouble(minDistance) - distance) / 2;
+                first.position.x = toDouble(fromDouble(first.position.x) - multiply(fixedNormalX, push));
+                first.position.y = toDouble(fromDouble(first.position.y) - multiply(fixedNormalY, push));
+                second.position.x = toDouble(fromDouble(second.position.x) + multiply(fixedNormalX, push));
+                second.position.y = toDouble(fromDouble(second.position.y) + multiply(fixedNormalY, push));
+
+                Fixed closing = multiply(fromDouble(first.velocity.x - second.velocity.x), fixedNormalX) +
+                                multiply(fromDouble(first.velocity.y - second.velocity.y), fixedNormalY);
+                if (closing <= 0) continue;
+
+                first.velocity.x = toDouble(fromDouble(first.velocity.x) - multiply(closing, fixedNormalX));
+                first.velocity.y = toDouble(fromDouble(first.velocity.y) - multiply(closing, fixedNormalY));
+                second.velocity.x = toDouble(fromDouble(second.velocity.x) + multiply(closing, fixedNormalX));
+                second.velocity.y = toDouble(fromDouble(second.velocity.y) + multiply(closing, fixedNormalY));
+                normalX = toDouble(fixedNormalX);
+                normalY = toDouble(fixedNormalY);
+                closingSpeed = toDouble(closing);
+            } else {
+                double distance = std::sqrt(distanceSquared);
+                normalX = deltaX / distance;
+                normalY = deltaY / distance;
+
+                // Push the pair apart so they no longer overlap
+                double push = (minDistance - distance) / 2.0;
+                first.position.x -= normalX * push;
+                first.position.y -= normalY * push;
+                second.position.x += normalX * push;
+                second.position.y += normalY * push;
+
+                closingSpeed = (first.velocity.x - second.velocity.x) * normalX +
+                               (first.velocity.y - second.velocity.y) * normalY;
+                if (closingSpeed <= 0.0) continue; // Already moving apart
+
+                // Equal masses: swap the velocity components along the contact normal
+                first.velocity.x -= closingSpeed * normalX;
+                first.velocity.y -= closingSpeed * normalY;
+                second.velocity.x += closingSpeed * normalX;
+                second.velocity.y += closingSpeed * normalY;
+            }
+
+            listener->onBallCollision(static_cast<float>(firstX + normalX * first.width / 2.0),
+                                      static_cast<float>(firstY + normalY * first.height / 2.0), closingSpeed);
+        }
+    }
+}
+
+void Match::addBall(const Ball& ball) {
+    balls.push_back(ball);
+    balls.back().coastUntil = 0;
+    if (rules.fixedPoint) {
+        balls.back().snapToFixed();
+    }
+    roundInProgress = true;
+}
+
+void Match::addPowerUp(int x, int y, PowerUpType type) {
+    powerUps.push_back(std::make_unique<PowerUp>(x, y, type, tickCount));
+    wakeAllBalls();
+    listener->onPowerUpSpawn(*powerUps.back());
+}
+
+uint64_t Match::computeStateHash() const {
+    // Everything the fixed-point simulation depends on; the effects stream is cosmetic and left out
+    StateHash hash;
+    hash.add(tickCount);
+    hash.add(rng.serve.getState());
+    hash.add(rng.spawn.getState());
+    hash.add(static_cast<int32_t>(player1Score));
+    hash.add(static_cast<int32_t>(player2Score));
+    hash.add(FixedPoint::fromDouble(leftPaddle.position.y));
+    hash.add(FixedPoint::fromDouble(rightPaddle.position.y));
+    for (const auto& ball : balls) {
+        hash.add(FixedPoint::fromDouble(ball.position.x));
+        hash.add(FixedPoint::fromDouble(ball.position.y));
+        hash.add(FixedPoint::fromDouble(ball.velocity.x));
+        hash.add(FixedPoint::fromDouble(ball.velocity.y));
+    }
+    for (const auto& powerUp : powerUps) {
+        hash.add(static_cast<int32_t>(powerUp->type));
+        hash.add(FixedPoint::fromDouble(powerUp->position.x));
+        hash.add(FixedPoint::fromDouble(powerUp->position.y));
+    }
+    return hash.value();
+}
+
+size_t Match::getMemoryUsage() const {
+    size_t bytes = sizeof(Match) + balls.capacity() * sizeof(Ball) +
+                   (nearbyBalls.capacity() + liveBalls.capacity()) * sizeof(int);
+    if (history) {
+        bytes += history->getMemoryUsage() + snapshot.capacity() * sizeof(uint32_t);
+    }
+    bytes += powerUps.capacity() * sizeof(std::unique_ptr<PowerUp>) + powerUps.size() * sizeof(PowerUp);
+    return bytes + collisionGrid.getMemoryUsage() + contactBatch.getMemoryUsage();
+}
+
+void Match::handlePaddleCollision(Ball& ball, Paddle& paddle) {
+    ball.reverseX();
+
+    // Track which player hit the ball
+    if (&paddle == &leftPaddle) {
+        ball.position.x = paddle.position.x + paddle.width;
+        lastPlayerToHit = 1;
+    } else {
+        ball.position.x = paddle.position.x - ball.width;
+        lastPlayerToHit = 2;
+    }
+
+    double impactPoint;
+    if (rules.fixedPoint) {
+        using namespace FixedPoint;
+        Fixed impact = divide(fromDouble(ball.getCenterY() - paddle.getCenterY()), fromInt(paddle.height) / 2);
+        Fixed maxSpeed = fromDouble(Constants::BALL_SPEED * 1.5);
+        ball.setVelY(toDouble(std::clamp(fromDouble(ball.getVelY()) + impact * 2, -maxSpeed, maxSpeed)));
+        impactPoint = toDouble(impact);
+    } else {
+        impactPoint = (ball.getCenterY() - paddle.getCenterY()) / (paddle.height / 2.0);
+        ball.setVelY(ball.getVelY() + impactPoint * 2.0);
+
+        // Limit the speed of just this ball
+        double maxSpeed = Constants::BALL_SPEED * 1.5;
+        if (std::abs(ball.getVelY()) > maxSpeed) {
+            ball.setVelY(ball.getVelY() > 0 ? maxSpeed : -maxSpeed);
+        }
+    }
+
+    listener->onPaddleHit(ball, lastPlayerToHit, impactPoint);
+}
+
+void Match::checkScore() {
+    if (!roundInProgress || scoreThisRound) return; // Already scored this round
+
+    for (const auto& ball : balls) {
+        int scorer = 0;
+        if (ball.position.x < 0) {
+            scorer = 2;
+            player2Score++;
+        } else if (ball.position.x > rules.arena.width) {
+            scorer = 1;
+            player1Score++;
+        } else {
+            continue;
+        }
+
+        listener->onScore(scorer, ball);
+        scoreThisRound = true;
+        clearAllBalls();
+        checkWinCondition();
+        serveBall();
+        return;
+    }
+}
+
+void Match::checkWinCondition() {
+    if (player1Score >= Constants::WIN_SCORE) {
+        winner = 1;
+        gameOver = true;
+    } else if (player2Score >= Constants::WIN_SCORE) {
+        winner = 2;
+        gameOver = true;
+    }
+
+    if (gameOver) {
+        listener->onMatchEnd(winner);
+    }
+}
+
+void Match::serveBall() {
+    if (!gameOver) {
+        clearAllBalls();
+        for (int i = 0; i < std::max(1, rules.ballCount); i++) {
+            balls.emplace_back(static_cast<int>(rules.arena.centerX()), static_cast<int>(rules.arena.centerY()), Constants::BALL_SIZE);
+            balls.back().serve(rules.arena, rng.serve);
+            if (rules.fixedPoint) {
+                balls.back().snapToFixed();
+            }
+        }
+        roundInProgress = true;
+        scoreThisRound = false;
+    }
+}
+
+void Match::spawnPowerUp() {
+    uint32_t ticksSinceLastSpawn = tickCount - lastPowerUpSpawnTick;
+
+    // Spawn a power-up every 15-25 seconds if none exist
+    if (ticksSinceLastSpawn >= 15 * Constants::FPS && powerUps.empty() && rng.spawn.nextDouble() < 0.1) {
+        // Spawn in the middle area of the arena, avoiding paddle zones
+        int x = rules.arena.width * 0.3 + rng.spawn.nextDouble() * rules.arena.width * 0.4;
+        int y = 50 + rng.spawn.nextDouble() * (rules.arena.height - 100);
+
+        // Randomly choose the type; REWIND is only offered while there is history to rewind to
+        double roll = rng.spawn.nextDouble();
+        PowerUpType type;
+        if (canRewind()) {
+            type = roll < 0.4 ? PowerUpType::MULTIBALL : roll < 0.8 ? PowerUpType::INVERT_CONTROLS : PowerUpType::REWIND;
+        } else {
+            type = roll < 0.5 ? PowerUpType::MULTIBALL : PowerUpType::INVERT_CONTROLS;
+        }
+
+        powerUps.push_back(std::make_unique<PowerUp>(x, y, type, tickCount));
+        lastPowerUpSpawnTick = tickCount;
+        wakeAllBalls();
+        listener->onPowerUpSpawn(*powerUps.back());
+    }
+}
+
+void Match::checkPowerUpCollisions() {
+    for (auto& powerUp : powerUps) {
+        if (!powerUp->active) continue;
+
+        for (const auto& ball : balls) {
+            if (ball.coastUntil > tickCount) continue; // Planned clear of every power-up
+            collisionChecks++;
+            SDL_Rect ballRect = ball.getRect();
+            SDL_Rect powerUpRect = powerUp->getRect();
+
+            // A REWIND with nothing to go back to stays on the field until there is
+            if (SDL_HasRectIntersection(&ballRect, &powerUpRect) &&
+                (powerUp->type != PowerUpType::REWIND || canRewind())) {
+                // Power-up collected!
+                powerUp->active = false;
+                listener->onPowerUpPickup(*powerUp, lastPlayerToHit);
+
+                switch (powerUp->type) {
+                    case PowerUpType::MULTIBALL:
+                        activateMultiball();
+                        break;
+                    case PowerUpType::INVERT_CONTROLS:
+                        activateInvertControls();
+                        break;
+                    case PowerUpType::REWIND:
+                        // Restoring replaces the power-up list, so wait for the end of the tick
+                        rewindPending = true;
+                        rewindPlayer = lastPlayerToHit;
+                        break;
+                }
+                break; // Only one ball can collect the power-up
+            }
+        }
+    }
+}
+
+void Match::activateInvertControls() {
+    // Apply control inversion to whichever player last hit the ball
+    // This ensures the power-up affects the opponent of whoever collected it
+    if (lastPlayerToHit == 1) {
+        player1ControlsInverted = true;
+        player2ControlsInverted = false;
+    } else if (lastPlayerToHit == 2) {
+        player2ControlsInverted = true;
+        player1ControlsInverted = false;
+    }
+
+    // Start the inversion timer - effect will last for CONTROL_INVERSION_DURATION seconds
+    controlInversionStartTick = tickCount;
+
+    if (lastPlayerToHit != 0) {
+        listener->onInversionStart(lastPlayerToHit);
+    }
+}
+
+void Match::updateControlInversion() {
+    // Check if any player currently has inverted controls
+    if (player1ControlsInverted || player2ControlsInverted) {
+        uint32_t inversionTicks = tickCount - controlInversionStartTick;
+
+        // Disable inversion after the duration expires (10 seconds)
+        if (inversionTicks >= static_cast<uint32_t>(CONTROL_INVERSION_DURATION * Constants::FPS)) {
+            listener->onInversionEnd(player1ControlsInverted ? 1 : 2);
+            player1ControlsInverted = false;
+            player2ControlsInverted = false;
+        }
+    }
+}
+
+void Match::activateMultiball() {
+    if (balls.empty()) return;
+
+    // Get the current ball's position and velocity
+    Ball& currentBall = balls[0];
+    Vector2 pos = currentBall.position;
+    Vector2 vel = currentBall.velocity;
+
+    // Clear existing balls
+    balls.clear();
+
+    // Spread the new balls in a fan 0.3 rad apart, closing up so large splits stay within a full turn
+    int count = std::max(1, rules.multiballCount);
+    double spread = std::min(0.3, 2.0 * M_PI / count);
+    double baseAngle = std::atan2(vel.y, vel.x);
+    double speed = vel.magnitude();
+
+    for (int i = 0; i < count; i++) {
+        double angle = baseAngle + (i - (count - 1) / 2.0) * spread;
+
+        Ball newBall(pos.x, pos.y, Constants::BALL_SIZE);
+        if (rules.fixedPoint) {
+            // libm trig differs between platforms; CORDIC does not
+            using namespace FixedPoint;
+            Fixed fixedAngle = FixedPoint::atan2(fromDouble(vel.y), fromDouble(vel.x)) + (2 * i - (count - 1)) * fromDouble(spread) / 2;
+            Fixed fixedSpeed = length(fromDouble(vel.x), fromDouble(vel.y));
+            Fixed sine, cosine;
+            sinCos(fixedAngle, sine, cosine);
+            newBall.velocity.x = toDouble(multiply(fixedSpeed, cosine));
+            newBall.velocity.y = toDouble(multiply(fixedSpeed, sine));
+        } else {
+            newBall.velocity.x = speed * std::cos(angle);
+            newBall.velocity.y = speed * std::sin(angle);
+        }
+
+        balls.push_back(newBall);
+    }
+}
+
+void Match::clearAllBalls() {
+    balls.clear();
+    powerUps.clear(); // Clear power-ups when round ends
+}
+
+void Match::activateRewind() {
+    uint32_t oldest;
+    if (!history || !history->getOldestTick(oldest)) return;
+
+    // The newest snapshot is from the end of the previous tick. Ticks skipped while the
+    // field was over the snapshot limits aren't held; the tick before them is used.
+    uint32_t rewindTicks = static_cast<uint32_t>(REWIND_SECONDS * Constants::FPS);
+    uint32_t target = tickCount - oldest > rewindTicks ? tickCount - rewindTicks : oldest;
+    int count;
+    const uint32_t* words = history->rewindTo(target, count);
+    if (!words) return;
+
+    uint32_t fromTick = tickCount;
+    bool wasInverted[2] = {player1ControlsInverted, player2ControlsInverted};
+    readSnapshot(words);
+
+    // Inversions the restore switched on or off are reported like any other
+    bool isInverted[2] = {player1ControlsInverted, player2ControlsInverted};
+    for (int player = 1; player <= 2; player++) {
+        if (wasInverted[player - 1] && !isInverted[player - 1]) {
+            listener->onInversionEnd(player);
+        }
+    }
+    for (int player = 1; player <= 2; player++) {
+        if (!wasInverted[player - 1] && isInverted[player - 1]) {
+            listener->onInversionStart(player);
+        }
+    }
+
+    // The rewind is spent; don't bring back the power-up that caused it
+    powerUps.erase(std::remove_if(powerUps.begin(), powerUps.end(), [](const std::unique_ptr<PowerUp>& powerUp) {
+        return powerUp->type == PowerUpType::REWIND;
+    }), powerUps.end());
+
+    listener->onRewind(rewindPlayer, fromTick - tickCount);
+}
+
+bool Match::canRewind() const {
+    uint32_t oldest;
+    return history && history->getOldestTick(oldest);
+}
+
+void Match::captureHistory() {
+    // Skip ticks that don't fit a snapshot; what was captured before stays rewindable
+    if (balls.size() > MAX_SNAPSHOT_BALLS || powerUps.size() > MAX_SNAPSHOT_POWERUPS) {
+        return;
+    }
+    history->capture(tickCount, snapshot.data(), writeSnapshot(snapshot.data()));
+}
+
+// Doubles go into two words bit for bit, so a restored match continues exactly
+static int putDouble(uint32_t* words, int n, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    words[n] = static_cast<uint32_t>(bits);
+    words[n + 1] = static_cast<uint32_t>(bits >> 32);
+    return n + 2;
+}
+
+static double getDouble(const uint32_t* words, int& n) {
+    uint64_t bits = words[n] | (static_cast<uint64_t>(words[n + 1]) << 32);
+    n += 2;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int Match::writeSnapshot(uint32_t* words) const {
+    // Fields that rarely change come first and stay put, so their XOR deltas are all zero
+    int n = 0;
+    words[n++] = tickCount;
+    words[n++] = static_cast<uint32_t>(player1Score) | (static_cast<uint32_t>(player2Score) << 16);
+    words[n++] = static_cast<uint32_t>(gameOver) | (roundInProgress << 1) | (scoreThisRound << 2) |
+                 (player1ControlsInverted << 3) | (player2ControlsInverted << 4) |
+                 (static_cast<uint32_t>(lastPlayerToHit) << 8) | (static_cast<uint32_t>(winner) << 12);
+    words[n++] = controlInversionStartTick;
+    words[n++] = lastPowerUpSpawnTick;
+    uint64_t serveState = rng.serve.getState(), spawnState = rng.spawn.getState();
+    words[n++] = static_cast<uint32_t>(serveState);
+    words[n++] = static_cast<uint32_t>(serveState >> 32);
+    words[n++] = static_cast<uint32_t>(spawnState);
+    words[n++] = static_cast<uint32_t>(spawnState >> 32);
+    n = putDouble(words, n, leftPaddle.position.y);
+    n = putDouble(words, n, rightPaddle.position.y);
+    words[n++] = static_cast<uint32_t>(balls.size());
+    words[n++] = static_cast<uint32_t>(powerUps.size());
+
+    for (const auto& ball : balls) {
+        n = putDouble(words, n, ball.position.x);
+        n = putDouble(words, n, ball.position.y);
+        n = putDouble(words, n, ball.velocity.x);
+        n = putDouble(words, n, ball.velocity.y);
+    }
+    for (const auto& powerUp : powerUps) {
+        words[n++] = static_cast<uint32_t>(powerUp->type);
+        words[n++] = powerUp->spawnTick;
+        words[n++] = powerUp->active;
+        words[n++] = static_cast<uint32_t>(static_cast<int32_t>(powerUp->position.x));
+        words[n++] = static_cast<uint32_t>(static_cast<int32_t>(powerUp->position.y));
+    }
+    return n;
+}
+
+void Match::readSnapshot(const uint32_t* words) {
+    int n = 0;
+    tickCount = words[n++];
+    player1Score = static_cast<int>(words[n] & 0xFFFF);
+    player2Score = static_cast<int>(words[n++] >> 16);
+    uint32_t flags = words[n++];
+    gameOver = flags & 1;
+    roundInProgress = (flags >> 1) & 1;
+    scoreThisRound = (flags >> 2) & 1;
+    player1ControlsInverted = (flags >> 3) & 1;
+    player2ControlsInverted = (flags >> 4) & 1;
+    lastPlayerToHit = static_cast<int>((flags >> 8) & 0xF);
+    winner = static_cast<int>((flags >> 12) & 0xF);
+    controlInversionStartTick = words[n++];
+    lastPowerUpSpawnTick = words[n++];
+    rng.serve.setState(words[n] | (static_cast<uint64_t>(words[n + 1]) << 32));
+    rng.spawn.setState(words[n + 2] | (static_cast<uint64_t>(words[n + 3]) << 32));
+    n += 4;
+    leftPaddle.position.y = getDouble(words, n);
+    rightPaddle.position.y = getDouble(words, n);
+    uint32_t ballCount = words[n++];
+    uint32_t powerUpCount = words[n++];
+
+    balls.clear();
+    for (uint32_t i = 0; i < ballCount; i++) {
+        Ball& ball = balls.emplace_back(0, 0, Constants::BALL_SIZE);
+        ball.position.x = getDouble(words, n);
+        ball.position.y = getDouble(words, n);
+        ball.velocity.x = getDouble(words, n);
+        ball.velocity.y = getDouble(words, n);
+    }
+    powerUps.clear();
+    for (uint32_t i = 0; i < powerUpCount; i++) {
+        PowerUpType type = static_cast<PowerUpType>(words[n]);
+        uint32_t spawnTick = words[n + 1];
+        bool active = words[n + 2] != 0;
+        int x = static_cast<int32_t>(words[n + 3]);
+        int y = static_cast<int32_t>(words[n + 4]);
+        n += POWERUP_WORDS;
+        powerUps.push_back(std::make_unique<PowerUp>(x, y, type, spawnTick));
+        powerUps.back()->active = active;
+    }
+}
@@ -0,0 +1,219 @@
+#include "Metrics.h"
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// macOS has no MSG_NOSIGNAL; SO_NOSIGPIPE is set on each client socket instead
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+constexpr double Metrics::FRAME_BUCKET_BOUNDS[Metrics::FRAME_BUCKET_COUNT];
+
+Metrics::Metrics()
+    : frameCount(0), frameTimeSumNs(0), droppedFrames(0), tickCount(0), collisionChecksTotal(0),
+      lastCollisionChecks(0), balls(0), powerUps(0), particles(0), redrawFraction(1.0), qualityLevel(0),
+      startupToWindow(0.0), windowToFirstFrame(0.0), serverRunning(false), listenSocket(-1) {
+    for (auto& bucket : frameBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+Metrics::~Metrics() {
+    stopServer();
+}
+
+void Metrics::recordFrame(double workSeconds, bool missedDeadline) {
+    int bucket = 0;
+    while (bucket < FRAME_BUCKET_COUNT && workSeconds > FRAME_BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    frameBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    frameCount.fetch_add(1, std::memory_order_relaxed);
+    frameTimeSumNs.fetch_add(static_cast<uint64_t>(workSeconds * 1e9), std::memory_order_relaxed);
+    if (missedDeadline) {
+        droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::recordTick(int ballCount, int powerUpCount, int particleCount, int collisionChecks) {
+    tickCount.fetch_add(1, std::memory_order_relaxed);
+    collisionChecksTotal.fetch_add(static_cast<uint64_t>(collisionChecks), std::memory_order_relaxed);
+    lastCollisionChecks.store(collisionChecks, std::memory_order_relaxed);
+    balls.store(ballCount, std::memory_order_relaxed);
+    powerUps.store(powerUpCount, std::memory_order_relaxed);
+    particles.store(particleCount, std::memory_order_relaxed);
+}
+
+void Metrics::recordRedraw(double windowFraction) {
+    redrawFraction.store(windowFraction, std::memory_order_relaxed);
+}
+
+void Metrics::recordQuality(int level) {
+    qualityLevel.store(level, std::memory_order_relaxed);
+}
+
+void Metrics::recordStartup(double secondsToWindow, double windowToFirstFrameSeconds) {
+    startupToWindow.store(secondsToWindow, std::memory_order_relaxed);
+    windowToFirstFrame.store(windowToFirstFrameSeconds, std::memory_order_relaxed);
+}
+
+std::string Metrics::renderPrometheus() const {
+    std::ostringstream out;
+
+    out << "# HELP pong_frame_time_seconds Time spent simulating and rendering each frame.\n"
+        << "# TYPE pong_frame_time_seconds histogram\n";
+    uint64_t cumulative = 0;
+    for (int i = 0; i < FRAME_BUCKET_COUNT; i++) {
+        cumulative += frameBuckets[i].load(std::memory_order_relaxed);
+        out << "pong_frame_time_seconds_bucket{le=\"" << FRAME_BUCKET_BOUNDS[i] << "\"} " << cumulative << "\n";
+    }
+    cumulative += frameBuckets[FRAME_BUCKET_COUNT].load(std::memory_order_relaxed);
+    out << "pong_frame_time_seconds_bucket{le=\"+Inf\"} " << cumulative << "\n"
+        << "pong_frame_time_seconds_sum " << frameTimeSumNs.load(std::memory_order_relaxed) / 1e9 << "\n"
+        << "pong_frame_time_seconds_count " << frameCount.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_dropped_frames_total Frames that arrived more than 1.5 frame intervals after the previous one.\n"
+        << "# TYPE pong_dropped_frames_total counter\n"
+        << "pong_dropped_frames_total " << droppedFrames.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_ticks_total Simulation ticks executed.\n"
+        << "# TYPE pong_ticks_total counter\n"
+        << "pong_ticks_total " << tickCount.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_collision_checks_total Ball collision tests against walls, paddles and power-ups.\n"
+        << "# TYPE pong_collision_checks_total counter\n"
+        << "pong_collision_checks_total " << collisionChecksTotal.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_collision_checks_per_tick Collision tests performed in the most recent tick.\n"
+        << "# TYPE pong_collision_checks_per_tick gauge\n"
+        << "pong_collision_checks_per_tick " << lastCollisionChecks.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_balls Balls currently in play.\n"
+        << "# TYPE pong_balls gauge\n"
+        << "pong_balls " << balls.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_powerups Power-ups currently on the field.\n"
+        << "# TYPE pong_powerups gauge\n"
+        << "pong_powerups " << powerUps.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_particles Live particles.\n"
+        << "# TYPE pong_particles gauge\n"
+        << "pong_particles " << particles.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_redraw_fraction Share of the window redrawn in the most recent frame.\n"
+        << "# TYPE pong_redraw_fraction gauge\n"
+        << "pong_redraw_fraction " << redrawFraction.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_render_quality_level Render detail level, 0 (full) to 4 (cheapest).\n"
+        << "# TYPE pong_render_quality_level gauge\n"
+        << "pong_render_quality_level " << qualityLevel.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_startup_window_seconds Time from initialization to window creation.\n"
+        << "# TYPE pong_startup_window_seconds gauge\n"
+        << "pong_startup_window_seconds " << startupToWindow.load(std::memory_order_relaxed) << "\n";
+
+    out << "# HELP pong_startup_first_frame_seconds Time from window creation to the first presented frame.\n"
+        << "# TYPE pong_startup_first_frame_seconds gauge\n"
+        << "pong_startup_first_frame_seconds " << windowToFirstFrame.load(std::memory_order_relaxed) << "\n";
+
+    return out.str();
+}
+
+#ifdef _WIN32
+
+bool Metrics::startServer(int /*port*/) {
+    std::cerr << "Metrics endpoint is not supported on Windows" << std::endl;
+    return false;
+}
+
+void Metrics::stopServer() {
+}
+
+void Metrics::serverLoop() {
+}
+
+#else
+
+bool Metrics::startServer(int port) {
+    if (serverRunning) return true;
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        std::cerr << "Metrics: could not create socket" << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Loopback only; this is an operator endpoint, not a public one
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenSocket, 4) < 0) {
+        std::cerr << "Metrics: could not listen on 127.0.0.1:" << port << std::endl;
+        close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    serverRunning = true;
+    server = std::thread(&Metrics::serverLoop, this);
+    std::cout << "Metrics available at http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void Metrics::stopServer() {
+    if (!serverRunning) return;
+    serverRunning = false;
+    server.join();
+    close(listenSocket);
+    listenSocket = -1;
+}
+
+void Metrics::serverLoop() {
+    while (serverRunning.load(std::memory_order_relaxed)) {
+        // Wake periodically so stopServer() doesn't wait on a blocked accept()
+        pollfd listener = {listenSocket, POLLIN, 0};
+        if (poll(&listener, 1, 200) <= 0) continue;
+
+        int client = accept(listenSocket, nullptr, nullptr);
+        if (client < 0) continue;
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+        // Every path serves the metrics page, so the request itself only needs draining
+        char request[1024];
+        pollfd readable = {client, POLLIN, 0};
+        if (poll(&readable, 1, 500) > 0) {
+            (void)recv(client, request, sizeof(request), 0);
+        }
+
+        std::string body = renderPrometheus();
+        std::string response = "HTTP/1.0 200 OK\r\n"
+                               "Content-Type: text/plain; version=0.0.4\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                               "Connection: close\r\n\r\n" + body;
+        size_t sent = 0;
+        while (sent < response.size()) {
+            ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) break;
+            sent += static_cast<size_t>(n);
+        }
+        close(client);
+    }
+}
+
+#endif
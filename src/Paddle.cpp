@@ -1,8 +1,9 @@
 #include "Paddle.h"
+#include "Camera.h"
 #include <algorithm>
 
-Paddle::Paddle(int x, int y, int width, int height, int speed)
-    : position(x, y), width(width), height(height), speed(speed) {
+Paddle::Paddle(int x, int y, int width, int height, int speed, int boundsHeight)
+    : position(x, y), width(width), height(height), speed(speed), boundsHeight(boundsHeight) {
 }
 
 void Paddle::moveUp() {
@@ -12,16 +13,15 @@ void Paddle::moveUp() {
 }
 
 void Paddle::moveDown() {
-    if (position.y < Constants::WINDOW_HEIGHT - height) {
+    if (position.y < boundsHeight - height) {
         position.y += speed;
     }
 }
 
-void Paddle::draw(SDL_Renderer* renderer) {
+void Paddle::draw(SDL_Renderer* renderer, const Camera& camera) const {
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
     SDL_Rect rect = getRect();
-    SDL_FRect frect = {static_cast<float>(rect.x), static_cast<float>(rect.y), 
-                       static_cast<float>(rect.w), static_cast<float>(rect.h)};
+    SDL_FRect frect = camera.toScreen(rect.x, rect.y, rect.w, rect.h);
     SDL_RenderFillRect(renderer, &frect);
 }
 
@@ -0,0 +1,228 @@
+#include "ParticleSystem.h"
+#include "Camera.h"
+#include "DirtyRegion.h"
+#include <cmath>
+
+ParticleSystem::ParticleSystem(Pcg32& random)
+    : posX(CAPACITY), posY(CAPACITY), velX(CAPACITY), velY(CAPACITY),
+      life(CAPACITY), invMaxLife(CAPACITY), size(CAPACITY), color(CAPACITY),
+      head(0), tail(0), preparedQuads(0), random(random) {
+
+    // A particle straddling rects is drawn once in each; the buffers grow past one
+    // index set per particle only in the rare frame where many do
+    vertices.resize(CAPACITY * 4);
+    indices.reserve(CAPACITY * 6);
+    quadRects.reserve(CAPACITY * 2);
+}
+
+void ParticleSystem::emit(float x, float y, float vx, float vy, float lifeTicks, float particleSize, SDL_Color c) {
+    // Full pool: recycle the oldest particle
+    if (head - tail == CAPACITY) {
+        tail++;
+    }
+
+    uint32_t i = static_cast<uint32_t>(head) & INDEX_MASK;
+    posX[i] = x;
+    posY[i] = y;
+    velX[i] = vx;
+    velY[i] = vy;
+    life[i] = lifeTicks;
+    invMaxLife[i] = 1.0f / lifeTicks;
+    size[i] = particleSize;
+    color[i] = (static_cast<uint32_t>(c.r) << 16) | (static_cast<uint32_t>(c.g) << 8) | c.b;
+    head++;
+}
+
+void ParticleSystem::emitBurst(float x, float y, int count, float speed, float lifeTicks, SDL_Color c) {
+    for (int i = 0; i < count; i++) {
+        float angle = random.nextFloat() * 6.2831853f;
+        float s = speed * (0.3f + 0.7f * random.nextFloat());
+        emit(x, y, std::cos(angle) * s, std::sin(angle) * s,
+             lifeTicks * (0.5f + 0.5f * random.nextFloat()), 3.0f, c);
+    }
+}
+
+void ParticleSystem::emitSparks(float x, float y, float dirX, int count, SDL_Color c) {
+    // Fan of sparks within +/-60 degrees of the rebound direction
+    float baseAngle = dirX >= 0.0f ? 0.0f : 3.1415927f;
+    for (int i = 0; i < count; i++) {
+        float angle = baseAngle + (random.nextFloat() - 0.5f) * 2.0943951f;
+        float s = 1.5f + 2.5f * random.nextFloat();
+        emit(x, y, std::cos(angle) * s, std::sin(angle) * s, 15.0f + 15.0f * random.nextFloat(), 2.0f, c);
+    }
+}
+
+void ParticleSystem::emitTrail(float x, float y, float vx, float vy) {
+    SDL_Color trailColor = {180, 180, 220, 255};
+    emit(x + (random.nextFloat() - 0.5f) * 4.0f, y + (random.nextFloat() - 0.5f) * 4.0f,
+         vx * 0.1f, vy * 0.1f, 12.0f, 3.0f, trailColor);
+}
+
+void ParticleSystem::emitSwirl(float centerX, float centerY, float radius, int count) {
+    SDL_Color swirlColor = {100, 150, 255, 255};
+    for (int i = 0; i < count; i++) {
+        float angle = random.nextFloat() * 6.2831853f;
+        float cosA = std::cos(angle);
+        float sinA = std::sin(angle);
+        // Mostly tangential motion with a slight inward drift reads as a slow vortex
+        float vx = -sinA * 1.2f - cosA * 0.6f;
+        float vy = cosA * 1.2f - sinA * 0.6f;
+        emit(centerX + cosA * radius, centerY + sinA * radius, vx, vy, 40.0f, 2.0f, swirlColor);
+    }
+}
+
+uint32_t ParticleSystem::updateSpan(uint32_t begin, uint32_t end) {
+    // Branch-free over contiguous slots so the compiler can vectorize it; counts the
+    // particles that expire on the way
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    float* __restrict vx = velX.data();
+    float* __restrict vy = velY.data();
+    float* __restrict l = life.data();
+    uint32_t expired = 0;
+    for (uint32_t i = begin; i < end; i++) {
+        px[i] += vx[i];
+        py[i] += vy[i];
+        vx[i] *= DRAG;
+        vy[i] *= DRAG;
+        l[i] -= 1.0f;
+        expired += l[i] <= 0.0f;
+    }
+    return expired;
+}
+
+void ParticleSystem::update() {
+    uint64_t count = head - tail;
+    if (count == 0) return;
+
+    // The live window may wrap around the end of the ring
+    uint32_t begin = static_cast<uint32_t>(tail) & INDEX_MASK;
+    uint32_t expired;
+    if (begin + count <= static_cast<uint64_t>(CAPACITY)) {
+        expired = updateSpan(begin, begin + static_cast<uint32_t>(count));
+    } else {
+        expired = updateSpan(begin, CAPACITY) + updateSpan(0, static_cast<uint32_t>(begin + count - CAPACITY));
+    }
+    if (expired == 0) return;
+
+    // Compact survivors toward the head, keeping their order, so [tail, head) holds only
+    // live particles again. Every slot is copied and the write index only moves on for
+    // live ones, so there is no branch to mispredict; a dead particle's copy lands in a
+    // slot the next survivor (or the new tail) covers.
+    uint64_t write = head;
+    for (uint64_t read = head; read > tail;) {
+        read--;
+        uint32_t from = static_cast<uint32_t>(read) & INDEX_MASK;
+        uint32_t to = static_cast<uint32_t>(write - 1) & INDEX_MASK;
+        posX[to] = posX[from];
+        posY[to] = posY[from];
+        velX[to] = velX[from];
+        velY[to] = velY[from];
+        life[to] = life[from];
+        invMaxLife[to] = invMaxLife[from];
+        size[to] = size[from];
+        color[to] = color[from];
+        write -= life[to] > 0.0f;
+    }
+    tail = write;
+}
+
+void ParticleSystem::prepareDraw(const Camera& camera, const DirtyRegion* region, size_t rectCount) {
+    SDL_Vertex* out = vertices.data();
+    int quadCount = 0;
+    quadRects.clear();
+
+    SDL_FRect view = camera.getViewRect();
+    float viewRight = view.x + view.w;
+    float viewBottom = view.y + view.h;
+    float zoom = camera.getZoom();
+
+    for (uint64_t k = tail; k < head; k++) {
+        uint32_t i = static_cast<uint32_t>(k) & INDEX_MASK;
+        if (life[i] <= 0.0f) continue;
+        float half = size[i] * 0.5f;
+        if (posX[i] + half < view.x || posX[i] - half > viewRight ||
+            posY[i] + half < view.y || posY[i] - half > viewBottom) continue;
+
+        float left = camera.toScreenX(posX[i] - half);
+        float top = camera.toScreenY(posY[i] - half);
+        float right = left + size[i] * zoom;
+        float bottom = top + size[i] * zoom;
+
+        if (region) {
+            overlapped.clear();
+            region->findRects({left, top, right - left, bottom - top}, overlapped);
+            if (overlapped.empty()) continue;
+            for (int rect : overlapped) {
+                quadRects.push_back(quadCount);
+                quadRects.push_back(rect);
+            }
+        } else {
+            quadRects.push_back(quadCount);
+            quadRects.push_back(0);
+        }
+
+        // Fade out over the particle's lifetime
+        SDL_FColor c = {
+            static_cast<float>((color[i] >> 16) & 0xFF) * (1.0f / 255.0f),
+            static_cast<float>((color[i] >> 8) & 0xFF) * (1.0f / 255.0f),
+            static_cast<float>(color[i] & 0xFF) * (1.0f / 255.0f),
+            life[i] * invMaxLife[i]
+        };
+        SDL_Vertex* quad = out + quadCount * 4;
+        quad[0] = {{left, top}, c, {0.0f, 0.0f}};
+        quad[1] = {{right, top}, c, {0.0f, 0.0f}};
+        quad[2] = {{right, bottom}, c, {0.0f, 0.0f}};
+        quad[3] = {{left, bottom}, c, {0.0f, 0.0f}};
+        quadCount++;
+    }
+
+    preparedQuads = quadCount;
+
+    // Counting sort of the quads by rect, keeping emission order within each
+    rectStarts.assign(rectCount + 1, 0);
+    for (size_t pair = 0; pair < quadRects.size(); pair += 2) {
+        rectStarts[quadRects[pair + 1] + 1] += 6;
+    }
+    for (size_t rect = 0; rect < rectCount; rect++) {
+        rectStarts[rect + 1] += rectStarts[rect];
+    }
+    indices.resize(rectStarts[rectCount]);
+    for (size_t pair = 0; pair < quadRects.size(); pair += 2) {
+        int v = quadRects[pair] * 4;
+        int* quad = &indices[rectStarts[quadRects[pair + 1]]];
+        quad[0] = v;     quad[1] = v + 1; quad[2] = v + 2;
+        quad[3] = v + 2; quad[4] = v + 3; quad[5] = v;
+        rectStarts[quadRects[pair + 1]] += 6;
+    }
+    // The fill moved each start to where the next rect begins; shift them back
+    for (size_t rect = rectCount; rect > 0; rect--) {
+        rectStarts[rect] = rectStarts[rect - 1];
+    }
+    rectStarts[0] = 0;
+}
+
+void ParticleSystem::draw(SDL_Renderer* renderer, size_t rect) {
+    if (rect + 1 >= rectStarts.size()) return;
+    size_t begin = rectStarts[rect];
+    int count = static_cast<int>(rectStarts[rect + 1] - begin);
+    if (count == 0) return;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(renderer, nullptr, vertices.data(), preparedQuads * 4, indices.data() + begin, count);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+void ParticleSystem::markDirty(DirtyRegion& region, const Camera& camera) const {
+    float zoom = camera.getZoom();
+    for (uint64_t k = tail; k < head; k++) {
+        uint32_t i = static_cast<uint32_t>(k) & INDEX_MASK;
+        if (life[i] <= 0.0f) continue;
+        float half = size[i] * 0.5f;
+        region.mark({camera.toScreenX(posX[i] - half), camera.toScreenY(posY[i] - half), size[i] * zoom, size[i] * zoom});
+    }
+}
+
+void ParticleSystem::clear() {
+    tail = head;
+}
@@ -1,21 +1,21 @@
 #include "PowerUp.h"
+#include "Camera.h"
 #include <cmath>
 
-PowerUp::PowerUp(int x, int y, PowerUpType powerUpType) 
+PowerUp::PowerUp(int x, int y, PowerUpType powerUpType, uint32_t spawnTick) 
     : position(x, y), width(30), height(30), type(powerUpType), 
-      spawnTime(std::chrono::high_resolution_clock::now()), active(true), pulseAnimation(0.0f) {
+      spawnTick(spawnTick), active(true), pulseAnimation(0.0f) {
 }
 
-void PowerUp::draw(SDL_Renderer* renderer) {
+void PowerUp::draw(SDL_Renderer* renderer, uint32_t currentTick, const Camera& camera, bool animate) {
     if (!active) return;
     
-    // Update pulse animation
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - spawnTime);
-    pulseAnimation = static_cast<float>(elapsed.count()) / 100.0f;
+    // Update pulse animation (one radian per 100 ms of game time)
+    float elapsedMs = static_cast<float>(currentTick - spawnTick) * 1000.0f / Constants::FPS;
+    pulseAnimation = elapsedMs / 100.0f;
     
     // Calculate pulsing effect
-    float pulse = 0.8f + 0.2f * std::sin(pulseAnimation);
+    float pulse = animate ? 0.8f + 0.2f * std::sin(pulseAnimation) : 1.0f;
     int pulseSize = static_cast<int>(width * pulse);
     int offset = (width - pulseSize) / 2;
     
@@ -24,24 +24,15 @@ void PowerUp::draw(SDL_Renderer* renderer) {
         case PowerUpType::MULTIBALL: {
             // Draw glowing multiball power-up
             SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255); // Gold color
-            SDL_FRect outerRect = {
-                static_cast<float>(position.x + offset), 
-                static_cast<float>(position.y + offset), 
-                static_cast<float>(pulseSize), 
-                static_cast<float>(pulseSize)
-            };
+            SDL_FRect outerRect = camera.toScreen(position.x + offset, position.y + offset, pulseSize, pulseSize);
             SDL_RenderFillRect(renderer, &outerRect);
             
             // Inner darker core
             SDL_SetRenderDrawColor(renderer, 255, 165, 0, 255); // Orange
             int coreSize = pulseSize * 0.6f;
             int coreOffset = (pulseSize - coreSize) / 2;
-            SDL_FRect coreRect = {
-                static_cast<float>(position.x + offset + coreOffset), 
-                static_cast<float>(position.y + offset + coreOffset), 
-                static_cast<float>(coreSize), 
-                static_cast<float>(coreSize)
-            };
+            SDL_FRect coreRect = camera.toScreen(position.x + offset + coreOffset, position.y + offset + coreOffset,
+                                                 coreSize, coreSize);
             SDL_RenderFillRect(renderer, &coreRect);
             
             // Draw multiple small circles to represent multiball
@@ -51,46 +42,27 @@ void PowerUp::draw(SDL_Renderer* renderer) {
             int ballRadius = 2;
             
             // Draw 5 small balls in a cross pattern
-            SDL_FRect ball1 = {static_cast<float>(centerX - ballRadius), static_cast<float>(centerY - ballRadius), 
-                              static_cast<float>(ballRadius * 2), static_cast<float>(ballRadius * 2)};
-            SDL_FRect ball2 = {static_cast<float>(centerX - ballRadius - 6), static_cast<float>(centerY - ballRadius), 
-                              static_cast<float>(ballRadius * 2), static_cast<float>(ballRadius * 2)};
-            SDL_FRect ball3 = {static_cast<float>(centerX - ballRadius + 6), static_cast<float>(centerY - ballRadius), 
-                              static_cast<float>(ballRadius * 2), static_cast<float>(ballRadius * 2)};
-            SDL_FRect ball4 = {static_cast<float>(centerX - ballRadius), static_cast<float>(centerY - ballRadius - 6), 
-                              static_cast<float>(ballRadius * 2), static_cast<float>(ballRadius * 2)};
-            SDL_FRect ball5 = {static_cast<float>(centerX - ballRadius), static_cast<float>(centerY - ballRadius + 6), 
-                              static_cast<float>(ballRadius * 2), static_cast<float>(ballRadius * 2)};
-            
-            SDL_RenderFillRect(renderer, &ball1);
-            SDL_RenderFillRect(renderer, &ball2);
-            SDL_RenderFillRect(renderer, &ball3);
-            SDL_RenderFillRect(renderer, &ball4);
-            SDL_RenderFillRect(renderer, &ball5);
+            const int ballOffsets[5][2] = {{0, 0}, {-6, 0}, {6, 0}, {0, -6}, {0, 6}};
+            for (const auto& ballOffset : ballOffsets) {
+                SDL_FRect smallBall = camera.toScreen(centerX - ballRadius + ballOffset[0], centerY - ballRadius + ballOffset[1],
+                                                      ballRadius * 2, ballRadius * 2);
+                SDL_RenderFillRect(renderer, &smallBall);
+            }
             break;
         }
             
         case PowerUpType::INVERT_CONTROLS: {
             // Draw glowing invert controls power-up
             SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red color
-            SDL_FRect outerRect = {
-                static_cast<float>(position.x + offset), 
-                static_cast<float>(position.y + offset), 
-                static_cast<float>(pulseSize), 
-                static_cast<float>(pulseSize)
-            };
+            SDL_FRect outerRect = camera.toScreen(position.x + offset, position.y + offset, pulseSize, pulseSize);
             SDL_RenderFillRect(renderer, &outerRect);
             
             // Inner darker core
             SDL_SetRenderDrawColor(renderer, 128, 0, 0, 255); // Dark red
             int coreSize = pulseSize * 0.6f;
             int coreOffset = (pulseSize - coreSize) / 2;
-            SDL_FRect coreRect = {
-                static_cast<float>(position.x + offset + coreOffset), 
-                static_cast<float>(position.y + offset + coreOffset), 
-                static_cast<float>(coreSize), 
-                static_cast<float>(coreSize)
-            };
+            SDL_FRect coreRect = camera.toScreen(position.x + offset + coreOffset, position.y + offset + coreOffset,
+                                                 coreSize, coreSize);
             SDL_RenderFillRect(renderer, &coreRect);
             
             // Draw arrows pointing in opposite directions to represent inversion
@@ -98,23 +70,51 @@ void PowerUp::draw(SDL_Renderer* renderer) {
             int centerX = position.x + width / 2;
             int centerY = position.y + height / 2;
             
-            // Up arrow (pointing down when inverted)
-            SDL_RenderLine(renderer, centerX - 4, centerY - 6, centerX, centerY - 2);
-            SDL_RenderLine(renderer, centerX + 4, centerY - 6, centerX, centerY - 2);
-            SDL_RenderLine(renderer, centerX, centerY - 2, centerX, centerY + 2);
+            // Up arrow (pointing down when inverted), then down arrow (pointing up when inverted)
+            const int arrowLines[5][4] = {
+                {-4, -6, 0, -2}, {4, -6, 0, -2}, {0, -2, 0, 2},
+                {-4, 6, 0, 2}, {4, 6, 0, 2}
+            };
+            for (const auto& line : arrowLines) {
+                SDL_RenderLine(renderer, camera.toScreenX(centerX + line[0]), camera.toScreenY(centerY + line[1]),
+                               camera.toScreenX(centerX + line[2]), camera.toScreenY(centerY + line[3]));
+            }
+            break;
+        }
+            
+        case PowerUpType::REWIND: {
+            // Draw glowing rewind power-up
+            SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255); // Cyan
+            SDL_FRect outerRect = camera.toScreen(position.x + offset, position.y + offset, pulseSize, pulseSize);
+            SDL_RenderFillRect(renderer, &outerRect);
             
-            // Down arrow (pointing up when inverted)
-            SDL_RenderLine(renderer, centerX - 4, centerY + 6, centerX, centerY + 2);
-            SDL_RenderLine(renderer, centerX + 4, centerY + 6, centerX, centerY + 2);
+            // Inner darker core
+            SDL_SetRenderDrawColor(renderer, 0, 100, 140, 255); // Dark teal
+            int coreSize = pulseSize * 0.6f;
+            int coreOffset = (pulseSize - coreSize) / 2;
+            SDL_FRect coreRect = camera.toScreen(position.x + offset + coreOffset, position.y + offset + coreOffset,
+                                                 coreSize, coreSize);
+            SDL_RenderFillRect(renderer, &coreRect);
+            
+            // Two left-pointing chevrons, the usual rewind symbol
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
+            int centerX = position.x + width / 2;
+            int centerY = position.y + height / 2;
+            const int chevronLines[4][4] = {
+                {-1, -4, -5, 0}, {-5, 0, -1, 4},
+                {5, -4, 1, 0}, {1, 0, 5, 4}
+            };
+            for (const auto& line : chevronLines) {
+                SDL_RenderLine(renderer, camera.toScreenX(centerX + line[0]), camera.toScreenY(centerY + line[1]),
+                               camera.toScreenX(centerX + line[2]), camera.toScreenY(centerY + line[3]));
+            }
             break;
         }
     }
 }
 
-bool PowerUp::isExpired() const {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - spawnTime);
-    return elapsed.count() >= LIFETIME_SECONDS;
+bool PowerUp::isExpired(uint32_t currentTick) const {
+    return currentTick - spawnTick >= static_cast<uint32_t>(LIFETIME_SECONDS * Constants::FPS);
 }
 
 SDL_Rect PowerUp::getRect() const {
@@ -0,0 +1,59 @@
+#include "QualityGovernor.h"
+#include <algorithm>
+
+QualityGovernor::QualityGovernor(double budgetSeconds)
+    : budget(budgetSeconds), level(QualityLevel::FULL), pinned(false),
+      windowFrames(0), slowFrames(0), windowWork(0.0), headroomWindows(0),
+      raiseDelayWindows(RAISE_DELAY_WINDOWS), windowsSinceRaise(MAX_RAISE_DELAY_WINDOWS),
+      droppedSinceRaise(true) {
+}
+
+void QualityGovernor::pin(QualityLevel pinnedLevel) {
+    level = pinnedLevel;
+    pinned = true;
+}
+
+bool QualityGovernor::recordFrame(double workSeconds) {
+    if (pinned) return false;
+
+    windowFrames++;
+    windowWork += workSeconds;
+    if (workSeconds > budget * OVER_BUDGET_FRACTION) {
+        slowFrames++;
+    }
+
+    // Drop as soon as the window has seen enough slow frames rather than waiting it out
+    bool drop = slowFrames >= SLOW_FRAMES_TO_DROP && level < QualityLevel::QUAD_BALLS;
+    if (!drop && windowFrames < WINDOW_FRAMES) return false;
+
+    bool headroom = !drop && windowWork / windowFrames < budget * HEADROOM_FRACTION;
+    windowFrames = 0;
+    slowFrames = 0;
+    windowWork = 0.0;
+    windowsSinceRaise = std::min(windowsSinceRaise + 1, MAX_RAISE_DELAY_WINDOWS);
+
+    if (drop) {
+        // Losing the level we just regained means the load sits at the edge; wait longer next time
+        if (windowsSinceRaise < raiseDelayWindows) {
+            raiseDelayWindows = std::min(raiseDelayWindows * 2, MAX_RAISE_DELAY_WINDOWS);
+        }
+        level = static_cast<QualityLevel>(static_cast<int>(level) + 1);
+        headroomWindows = 0;
+        droppedSinceRaise = true;
+        return true;
+    }
+
+    headroomWindows = headroom ? headroomWindows + 1 : 0;
+    if (headroomWindows >= raiseDelayWindows && level > QualityLevel::FULL) {
+        // The previous step up held, so the load has moved away from the edge; recover faster
+        if (!droppedSinceRaise) {
+            raiseDelayWindows = std::max(raiseDelayWindows / 2, RAISE_DELAY_WINDOWS);
+        }
+        droppedSinceRaise = false;
+        level = static_cast<QualityLevel>(static_cast<int>(level) - 1);
+        headroomWindows = 0;
+        windowsSinceRaise = 0;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,199 @@
+#include "RoomHost.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+RoomHost::RoomHost(const MatchRules& rules, int roomCount, int threadCount, uint64_t seed)
+    : threadCount(std::max(1, threadCount)),
+      period(std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(Constants::FRAME_DURATION_US))),
+      workerStats(this->threadCount), elapsedSeconds(0.0) {
+    // Rewind history is a few MB per match, far over a room's budget
+    MatchRules roomRules = rules;
+    roomRules.rewind = false;
+
+    // Room i plays seed + i, so any room can be replayed in the game with --seed --no-rewind
+    rooms.reserve(roomCount);
+    for (int i = 0; i < roomCount; i++) {
+        rooms.push_back(std::make_unique<Room>(roomRules, seed + i, i));
+    }
+}
+
+void RoomHost::run(double seconds) {
+    // Stagger the first deadlines across one period so rooms don't all come due at once
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < rooms.size(); i++) {
+        rooms[i]->deadline = start + period * static_cast<int64_t>(i) / static_cast<int64_t>(rooms.size());
+        schedule.emplace(rooms[i]->deadline, static_cast<int>(i));
+    }
+
+    Clock::time_point endTime = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&RoomHost::workerLoop, this, i, endTime);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void RoomHost::workerLoop(int worker, Clock::time_point endTime) {
+    WorkerStats& stats = workerStats[worker];
+    std::unique_lock<std::mutex> lock(scheduleMutex);
+
+    while (true) {
+        if (schedule.empty()) {
+            // Every room is being ticked by another worker
+            scheduleChanged.wait(lock);
+            continue;
+        }
+
+        Deadline next = schedule.top();
+        if (next.first >= endTime) {
+            break;
+        }
+        if (Clock::now() < next.first) {
+            scheduleChanged.wait_until(lock, next.first);
+            continue;
+        }
+        schedule.pop();
+        lock.unlock();
+
+        Room& room = *rooms[next.second];
+        tickRoom(room, stats);
+
+        lock.lock();
+        schedule.emplace(room.deadline, next.second);
+        // Sleeping workers wait on the old earliest deadline; wake one if this room beats it
+        if (schedule.top().second == next.second) {
+            scheduleChanged.notify_one();
+        }
+    }
+
+    // Wake the others so they see the end of the run too
+    scheduleChanged.notify_all();
+}
+
+void RoomHost::tickRoom(Room& room, WorkerStats& stats) {
+    Clock::time_point now = Clock::now();
+    int64_t latenessUs = std::max<int64_t>(0,
+        std::chrono::duration_cast<std::chrono::microseconds>(now - room.deadline).count());
+
+    room.ticks++;
+    room.latenessSumUs += latenessUs;
+    room.maxLatenessUs = std::max(room.maxLatenessUs, latenessUs);
+    if (now - room.deadline > period) {
+        room.lateTicks++;
+    }
+    stats.latenessBuckets[std::min<int64_t>(latenessUs / LATENESS_BUCKET_US, LATENESS_BUCKET_COUNT - 1)]++;
+    stats.ticks++;
+
+    Match& match = room.match;
+    match.tick(botInput(match, match.getLeftPaddle(), true), botInput(match, match.getRightPaddle(), false));
+    if (match.isOver()) {
+        room.matchesPlayed++;
+        match.reset();
+    }
+
+    // Keep the cadence: the next deadline follows from this one, not from when the tick ran,
+    // so a briefly late room catches up. A room far behind drops the backlog instead.
+    room.deadline += period;
+    if (now - room.deadline > period * MAX_CATCHUP_TICKS) {
+        int64_t behind = (now - room.deadline) / period;
+        room.deadline += period * behind;
+        room.skippedTicks += static_cast<uint32_t>(behind);
+    }
+
+    stats.busySeconds += std::chrono::duration<double>(Clock::now() - now).count();
+}
+
+PaddleInput RoomHost::botInput(const Match& match, const Paddle& paddle, bool leftSide) {
+    // Follow the nearest ball coming this way; with none, drift back to the middle
+    double targetY = match.getArena().centerY();
+    double nearest = match.getArena().width;
+    for (const auto& ball : match.getBalls()) {
+        bool approaching = leftSide ? ball.getVelX() < 0 : ball.getVelX() > 0;
+        double distance = std::abs(ball.position.x - paddle.position.x);
+        if (approaching && distance < nearest) {
+            nearest = distance;
+            targetY = ball.getCenterY();
+        }
+    }
+
+    // The dead zone keeps the paddle from jittering and leaves the bot beatable on edge hits
+    PaddleInput input;
+    double offset = targetY - paddle.getCenterY();
+    input.up = offset < -paddle.height / 4.0;
+    input.down = offset > paddle.height / 4.0;
+    return input;
+}
+
+void RoomHost::printReport(std::ostream& out) const {
+    uint64_t totalTicks = 0;
+    double busySeconds = 0.0;
+    std::vector<uint64_t> buckets(LATENESS_BUCKET_COUNT, 0);
+    for (const auto& stats : workerStats) {
+        totalTicks += stats.ticks;
+        busySeconds += stats.busySeconds;
+        for (int i = 0; i < LATENESS_BUCKET_COUNT; i++) {
+            buckets[i] += stats.latenessBuckets[i];
+        }
+    }
+
+    // Upper edge of the bucket holding the given fraction of ticks
+    auto percentileUs = [&](double fraction) {
+        uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * totalTicks));
+        uint64_t seen = 0;
+        for (int i = 0; i < LATENESS_BUCKET_COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= rank && seen > 0) return (i + 1) * LATENESS_BUCKET_US;
+        }
+        return LATENESS_BUCKET_COUNT * LATENESS_BUCKET_US;
+    };
+
+    size_t totalMemory = 0, maxMemory = 0;
+    uint64_t lateTicks = 0, skippedTicks = 0, matches = 0;
+    int64_t maxLatenessUs = 0;
+    for (const auto& room : rooms) {
+        size_t memory = sizeof(Room) - sizeof(Match) + room->match.getMemoryUsage();
+        totalMemory += memory;
+        maxMemory = std::max(maxMemory, memory);
+        lateTicks += room->lateTicks;
+        skippedTicks += room->skippedTicks;
+        matches += room->matchesPlayed;
+        maxLatenessUs = std::max(maxLatenessUs, room->maxLatenessUs);
+    }
+    size_t roomCount = std::max<size_t>(1, rooms.size());
+
+    out << std::fixed << std::setprecision(1);
+    out << "Rooms: " << rooms.size() << " on " << threadCount << " threads for " << elapsedSeconds << " s\n";
+    out << "Memory per room: " << totalMemory / roomCount << " bytes average, " << maxMemory << " max\n";
+    out << "Ticks: " << totalTicks << " (" << totalTicks / std::max(elapsedSeconds, 1e-9) << "/s, target "
+        << rooms.size() * Constants::FPS << "/s)\n";
+    out << "Worker load: " << 100.0 * busySeconds / std::max(elapsedSeconds * threadCount, 1e-9) << "%\n";
+    out << "Tick lateness: p50 < " << percentileUs(0.5) << " us, p99 < " << percentileUs(0.99) << " us, p99.9 < "
+        << percentileUs(0.999) << " us, max " << maxLatenessUs << " us\n";
+    out << "Late ticks (over one period): " << lateTicks << ", skipped: " << skippedTicks << "\n";
+    out << "Matches completed: " << matches << "\n";
+
+    // Per-room lateness, worst first
+    std::vector<const Room*> worst;
+    for (const auto& room : rooms) {
+        worst.push_back(room.get());
+    }
+    size_t shown = std::min<size_t>(10, worst.size());
+    std::partial_sort(worst.begin(), worst.begin() + shown, worst.end(), [](const Room* a, const Room* b) {
+        return a->maxLatenessUs > b->maxLatenessUs;
+    });
+    out << "Latest rooms:\n";
+    out << "  room    ticks  mean us   max us   late  skipped  matches\n";
+    for (size_t i = 0; i < shown; i++) {
+        const Room& room = *worst[i];
+        out << "  " << std::setw(4) << room.id << std::setw(9) << room.ticks
+            << std::setw(9) << (room.ticks ? static_cast<double>(room.latenessSumUs) / room.ticks : 0.0)
+            << std::setw(9) << room.maxLatenessUs << std::setw(7) << room.lateTicks
+            << std::setw(9) << room.skippedTicks << std::setw(9) << room.matchesPlayed << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,188 @@
+#include "Scenario.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+static bool parseSwitch(const std::string& value, bool& result) {
+    if (value == "on") {
+        result = true;
+    } else if (value == "off") {
+        result = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool Scenario::load(const std::string& path, Scenario& scenario) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open scenario " << path << std::endl;
+        return false;
+    }
+
+    scenario = Scenario();
+    scenario.name = path;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": expected <key> = <value>" << std::endl;
+            return false;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        std::istringstream values(value);
+        bool valid = !value.empty();
+
+        if (key == "name") {
+            scenario.name = value;
+        } else if (key == "balls") {
+            int count;
+            while (values >> count) {
+                valid = valid && count > 0;
+                scenario.ballCounts.push_back(count);
+            }
+            valid = valid && values.eof();
+        } else if (key == "pattern") {
+            if (value == "center") {
+                scenario.pattern = SpawnPattern::CENTER;
+            } else if (value == "grid") {
+                scenario.pattern = SpawnPattern::GRID;
+            } else if (value == "random") {
+                scenario.pattern = SpawnPattern::RANDOM;
+            } else if (value == "ring") {
+                scenario.pattern = SpawnPattern::RING;
+            } else {
+                valid = false;
+            }
+        } else if (key == "speed") {
+            valid = static_cast<bool>(values >> scenario.minSpeed) && scenario.minSpeed > 0.0;
+            if (!(values >> scenario.maxSpeed)) {
+                scenario.maxSpeed = scenario.minSpeed;
+            }
+            valid = valid && scenario.maxSpeed >= scenario.minSpeed;
+        } else if (key == "power_ups") {
+            scenario.powerUps = std::atoi(value.c_str());
+            valid = scenario.powerUps >= 0;
+        } else if (key == "ticks") {
+            scenario.ticks = std::atoi(value.c_str());
+            valid = scenario.ticks > 0;
+        } else if (key == "arena") {
+            valid = scenario.rules.arena.parse(value);
+        } else if (key == "gravity") {
+            valid = parseSwitch(value, scenario.rules.gravity);
+        } else if (key == "collisions") {
+            valid = parseSwitch(value, scenario.rules.ballCollisions);
+        } else if (key == "fixed_point") {
+            valid = parseSwitch(value, scenario.rules.fixedPoint);
+        } else if (key == "rewind") {
+            valid = parseSwitch(value, scenario.rules.rewind);
+        } else if (key == "event_flight") {
+            valid = parseSwitch(value, scenario.rules.eventFlight);
+        } else if (key == "walls") {
+            if (value == "bounce") {
+                scenario.rules.wallMode = WallMode::BOUNCE;
+            } else if (value == "wrap") {
+                scenario.rules.wallMode = WallMode::WRAP;
+            } else {
+                valid = false;
+            }
+        } else if (key == "multiball") {
+            scenario.rules.multiballCount = std::atoi(value.c_str());
+            valid = scenario.rules.multiballCount > 0;
+        } else {
+            std::cerr << path << ":" << lineNumber << ": unknown key '" << key << "'" << std::endl;
+            return false;
+        }
+
+        if (!valid) {
+            std::cerr << path << ":" << lineNumber << ": invalid value for '" << key << "': " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (scenario.rules.fixedPoint && !scenario.rules.arena.fitsFixedPoint()) {
+        std::cerr << path << ": arena " << scenario.rules.arena.width << "x" << scenario.rules.arena.height
+                  << " is too large for fixed_point (at most " << Arena::MAX_FIXED_POINT_SIZE << " on each side)"
+                  << std::endl;
+        return false;
+    }
+    if (scenario.ballCounts.empty()) {
+        std::cerr << path << ": no ball counts given (balls = <n> ...)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Scenario::populate(Match& match, int ballCount, Pcg32& rng) const {
+    if (match.isOver()) {
+        match.reset();
+    }
+
+    const Arena& arena = match.getArena();
+    for (int index = static_cast<int>(match.getBalls().size()); index < ballCount; index++) {
+        match.addBall(spawnBall(arena, index, ballCount, rng));
+    }
+
+    // Same band the match spawns its own power-ups in
+    for (int count = static_cast<int>(match.getPowerUps().size()); count < powerUps; count++) {
+        int x = static_cast<int>(arena.width * 0.3 + rng.nextDouble() * arena.width * 0.4);
+        int y = static_cast<int>(50 + rng.nextDouble() * (arena.height - 100));
+        int types = rules.rewind ? 3 : 2;
+        match.addPowerUp(x, y, static_cast<PowerUpType>(rng.next() % types));
+    }
+}
+
+Ball Scenario::spawnBall(const Arena& arena, int index, int ballCount, Pcg32& rng) const {
+    // Ball centers stay clear of the paddle columns so new balls don't score or bounce on
+    // their first tick
+    double left = Constants::LEFT_PADDLE_START_X + Constants::PADDLE_WIDTH + Constants::BALL_SIZE;
+    double width = arena.rightPaddleX() - Constants::BALL_SIZE - left;
+    double height = arena.height - Constants::BALL_SIZE;
+
+    double x = arena.centerX(), y = arena.centerY();
+    double angle = rng.nextDouble() * 2.0 * M_PI;
+    switch (pattern) {
+        case SpawnPattern::CENTER:
+            break;
+        case SpawnPattern::GRID: {
+            int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(ballCount * width / height))));
+            int rows = (ballCount + columns - 1) / columns;
+            x = left + (index % columns + 0.5) * width / columns;
+            y = Constants::BALL_SIZE / 2.0 + (index / columns + 0.5) * height / rows;
+            break;
+        }
+        case SpawnPattern::RANDOM:
+            x = left + rng.nextDouble() * width;
+            y = Constants::BALL_SIZE / 2.0 + rng.nextDouble() * height;
+            break;
+        case SpawnPattern::RING: {
+            angle = 2.0 * M_PI * index / ballCount;
+            double radius = std::min(width, height) * 0.4;
+            x = arena.centerX() + std::cos(angle) * radius;
+            y = arena.centerY() + std::sin(angle) * radius;
+            break;
+        }
+    }
+
+    double speed = minSpeed + rng.nextDouble() * (maxSpeed - minSpeed);
+    Ball ball(static_cast<int>(x - Constants::BALL_SIZE / 2.0), static_cast<int>(y - Constants::BALL_SIZE / 2.0),
+              Constants::BALL_SIZE);
+    ball.velocity = Vector2(std::cos(angle) * speed, std::sin(angle) * speed);
+    return ball;
+}
@@ -0,0 +1,59 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid() : columns(0), rows(0) {
+}
+
+int SpatialGrid::cellFor(double x, double y) const {
+    // Balls that have left the arena (about to score) are binned into the edge cells
+    int column = std::clamp(static_cast<int>(std::floor(x / CELL_SIZE)), 0, columns - 1);
+    int row = std::clamp(static_cast<int>(std::floor(y / CELL_SIZE)), 0, rows - 1);
+    return row * columns + column;
+}
+
+void SpatialGrid::build(const std::vector<Ball>& balls, const Arena& arena) {
+    columns = std::max(1, (arena.width + CELL_SIZE - 1) / CELL_SIZE);
+    rows = std::max(1, (arena.height + CELL_SIZE - 1) / CELL_SIZE);
+    int cellCount = columns * rows;
+
+    // Count balls per cell, turn the counts into offsets, then scatter
+    cellStart.assign(cellCount + 1, 0);
+    ballCells.resize(balls.size());
+    for (size_t i = 0; i < balls.size(); i++) {
+        int cell = cellFor(balls[i].position.x + balls[i].width / 2.0, balls[i].getCenterY());
+        ballCells[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (int cell = 0; cell < cellCount; cell++) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    items.resize(balls.size());
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < balls.size(); i++) {
+        items[cursor[ballCells[i]]++] = static_cast<int>(i);
+    }
+}
+
+void SpatialGrid::query(const SDL_FRect& area, std::vector<int>& out) const {
+    if (columns == 0) return;
+
+    // Widen by a ball so balls centered just outside the area still count
+    double margin = Constants::BALL_SIZE;
+    int firstColumn = std::clamp(static_cast<int>(std::floor((area.x - margin) / CELL_SIZE)), 0, columns - 1);
+    int lastColumn = std::clamp(static_cast<int>(std::floor((area.x + area.w + margin) / CELL_SIZE)), 0, columns - 1);
+    int firstRow = std::clamp(static_cast<int>(std::floor((area.y - margin) / CELL_SIZE)), 0, rows - 1);
+    int lastRow = std::clamp(static_cast<int>(std::floor((area.y + area.h + margin) / CELL_SIZE)), 0, rows - 1);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        // Cells in a row are contiguous in items, so each row is one run
+        int begin = cellStart[row * columns + firstColumn];
+        int end = cellStart[row * columns + lastColumn + 1];
+        out.insert(out.end(), items.begin() + begin, items.begin() + end);
+    }
+}
+
+size_t SpatialGrid::getMemoryUsage() const {
+    return (cellStart.capacity() + items.capacity() + ballCells.capacity() + cursor.capacity()) * sizeof(int);
+}
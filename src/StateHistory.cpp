@@ -0,0 +1,152 @@
+#include "StateHistory.h"
+#include <algorithm>
+
+StateHistory::StateHistory(int maxWords, size_t byteCapacity, int tickCapacity)
+    : maxWords(maxWords), bytes(byteCapacity), entries(tickCapacity),
+      previous(maxWords, 0), restored(maxWords, 0), previousCount(0),
+      firstEntry(0), entryCount(0), deltaRun(0), writeOffset(0) {
+}
+
+void StateHistory::clear() {
+    firstEntry = 0;
+    entryCount = 0;
+    deltaRun = 0;
+    writeOffset = 0;
+    previousCount = 0;
+}
+
+void StateHistory::capture(uint32_t tick, const uint32_t* words, int count) {
+    if (count > maxWords || (count + 3) / 4 + count * 4 > static_cast<int>(bytes.size())) {
+        clear();
+        return;
+    }
+    if (entryCount > 0 && tick <= entryAt(entryCount - 1).tick) {
+        clear();
+    }
+    if (entryCount == static_cast<int>(entries.size())) {
+        dropOldest();
+    }
+
+    bool keyframe = entryCount == 0 || count != previousCount || deltaRun + 1 >= KEYFRAME_INTERVAL;
+    uint32_t maxLength = static_cast<uint32_t>((count + 3) / 4 + count * 4);
+
+    // Live bytes run from the oldest entry to writeOffset, possibly wrapping; make room
+    // by dropping the oldest entries until the next maxLength bytes are free
+    if (writeOffset + maxLength > bytes.size()) {
+        while (entryCount > 0 && entryAt(0).offset >= writeOffset) {
+            dropOldest();
+        }
+        writeOffset = 0;
+    }
+    while (entryCount > 0 && entryAt(0).offset >= writeOffset && entryAt(0).offset < writeOffset + maxLength) {
+        dropOldest();
+    }
+
+    if (entryCount == 0) {
+        keyframe = true;
+    }
+    deltaRun = keyframe ? 0 : deltaRun + 1;
+
+    Entry& entry = entries[(firstEntry + entryCount) % entries.size()];
+    entry.tick = tick;
+    entry.offset = writeOffset;
+    entry.length = encode(words, keyframe ? nullptr : previous.data(), count, &bytes[writeOffset]);
+    entry.words = static_cast<uint32_t>(count);
+    entry.keyframe = keyframe;
+    writeOffset += entry.length;
+    entryCount++;
+
+    std::copy(words, words + count, previous.begin());
+    previousCount = count;
+}
+
+bool StateHistory::getOldestTick(uint32_t& tick) const {
+    // Deltas before the first keyframe lost their base when older entries were dropped
+    for (int age = 0; age < entryCount; age++) {
+        if (entryAt(age).keyframe) {
+            tick = entryAt(age).tick;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StateHistory::getNewestTick(uint32_t& tick) const {
+    if (entryCount == 0) return false;
+    tick = entryAt(entryCount - 1).tick;
+    return true;
+}
+
+const uint32_t* StateHistory::rewindTo(uint32_t tick, int& count) {
+    // Rewinds reach back a few seconds, so search from the newest end
+    int age = entryCount - 1;
+    while (age >= 0 && entryAt(age).tick > tick) {
+        age--;
+    }
+    if (age < 0) return nullptr;
+    int key = age;
+    while (key >= 0 && !entryAt(key).keyframe) {
+        key--;
+    }
+    if (key < 0) return nullptr;
+
+    const Entry& target = entryAt(age);
+    std::fill(restored.begin(), restored.begin() + entryAt(key).words, 0u);
+    for (int i = key; i <= age; i++) {
+        decode(entryAt(i), restored.data());
+    }
+    count = static_cast<int>(target.words);
+
+    // Forget everything after the restored tick
+    entryCount = age + 1;
+    deltaRun = age - key;
+    writeOffset = target.offset + target.length;
+    std::copy(restored.begin(), restored.begin() + count, previous.begin());
+    previousCount = count;
+    return restored.data();
+}
+
+size_t StateHistory::getMemoryUsage() const {
+    return bytes.capacity() + entries.capacity() * sizeof(Entry) +
+           (previous.capacity() + restored.capacity()) * sizeof(uint32_t);
+}
+
+void StateHistory::dropOldest() {
+    firstEntry = (firstEntry + 1) % static_cast<int>(entries.size());
+    entryCount--;
+}
+
+uint32_t StateHistory::encode(const uint32_t* words, const uint32_t* base, int count, uint8_t* out) const {
+    uint32_t length = 0;
+    for (int group = 0; group < count; group += 4) {
+        uint32_t tag = length++;
+        out[tag] = 0;
+        for (int i = group; i < std::min(group + 4, count); i++) {
+            uint32_t delta = base ? words[i] ^ base[i] : words[i];
+            int code = delta == 0 ? 0 : delta <= 0xFF ? 1 : delta <= 0xFFFF ? 2 : 3;
+            out[tag] |= static_cast<uint8_t>(code << ((i - group) * 2));
+            int size = code == 3 ? 4 : code;
+            for (int b = 0; b < size; b++) {
+                out[length++] = static_cast<uint8_t>(delta >> (b * 8));
+            }
+        }
+    }
+    return length;
+}
+
+void StateHistory::decode(const Entry& entry, uint32_t* words) const {
+    const uint8_t* in = &bytes[entry.offset];
+    int count = static_cast<int>(entry.words);
+    for (int group = 0; group < count; group += 4) {
+        uint8_t tag = *in++;
+        for (int i = group; i < std::min(group + 4, count); i++) {
+            int code = (tag >> ((i - group) * 2)) & 3;
+            int size = code == 3 ? 4 : code;
+            uint32_t delta = 0;
+            for (int b = 0; b < size; b++) {
+                delta |= static_cast<uint32_t>(*in++) << (b * 8);
+            }
+            words[i] ^= delta;
+        }
+    }
+}
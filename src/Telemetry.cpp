@@ -0,0 +1,79 @@
+#include "Telemetry.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+Telemetry::Telemetry()
+    : active(false), ring(std::make_unique<SpscRing<TelemetryEvent, RING_CAPACITY>>()),
+      writerRunning(false), droppedEvents(0), file(nullptr), writtenEvents(0) {
+}
+
+Telemetry::~Telemetry() {
+    stop();
+}
+
+bool Telemetry::start(const std::string& path) {
+    if (active) stop();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Could not open telemetry file: " << path << std::endl;
+        return false;
+    }
+
+    TelemetryFileHeader header = {};
+    std::memcpy(header.magic, "PONGTEL", 8);
+    header.version = FORMAT_VERSION;
+    header.eventSize = sizeof(TelemetryEvent);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    droppedEvents = 0;
+    writtenEvents = 0;
+    writerRunning = true;
+    writer = std::thread(&Telemetry::writerLoop, this);
+    active = true;
+    return true;
+}
+
+void Telemetry::stop() {
+    if (!active) return;
+    active = false;
+
+    writerRunning = false;
+    writer.join();
+    drain(); // Pick up anything emitted after the writer's last pass
+
+    std::fclose(file);
+    file = nullptr;
+
+    std::cout << "Telemetry: " << writtenEvents << " events written, "
+              << getDroppedEvents() << " dropped" << std::endl;
+}
+
+size_t Telemetry::drain() {
+    // Batch events so each fwrite covers many records
+    TelemetryEvent batch[256];
+    size_t total = 0;
+    size_t count;
+    do {
+        count = 0;
+        while (count < 256 && ring->pop(batch[count])) {
+            count++;
+        }
+        if (count > 0) {
+            std::fwrite(batch, sizeof(TelemetryEvent), count, file);
+            total += count;
+        }
+    } while (count == 256);
+    writtenEvents += total;
+    return total;
+}
+
+void Telemetry::writerLoop() {
+    // Poll rather than wait on a condition variable so the producer never has to signal
+    while (writerRunning.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
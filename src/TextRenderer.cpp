@@ -0,0 +1,203 @@
+#include "TextRenderer.h"
+#include <cstring>
+#include <iostream>
+
+TextRenderer::TextRenderer()
+    : renderer(nullptr), ttfInitialized(false), fontData(nullptr), fontDataSize(0),
+      largeFont(nullptr), smallFont(nullptr), nextWarmGlyph(-1),
+      glyphTextures(), glyphAdvances(), glyphTexturesReady(false) {
+}
+
+TextRenderer::~TextRenderer() {
+    shutdown();
+}
+
+bool TextRenderer::loadFontData() {
+    // Load fonts with proper fallbacks for each platform
+    const char* fontPaths[] = {
+#ifdef __APPLE__
+        "/System/Library/Fonts/Geneva.ttf",
+        "/System/Library/Fonts/Monaco.ttf",
+        "/System/Library/Fonts/SFCompact.ttf",
+        "/System/Library/Fonts/ArialHB.ttc",
+#elif __linux__
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+        "/usr/share/fonts/TTF/arial.ttf",
+#elif _WIN32
+        "C:\\Windows\\Fonts\\arial.ttf",
+        "C:\\Windows\\Fonts\\calibri.ttf",
+        "C:\\Windows\\Fonts\\tahoma.ttf",
+#endif
+        nullptr
+    };
+
+    // Read the first font that exists into memory; every font handle is opened from this copy
+    for (int i = 0; fontPaths[i] != nullptr; i++) {
+        fontData = SDL_LoadFile(fontPaths[i], &fontDataSize);
+        if (fontData) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextRenderer::initialize(SDL_Renderer* targetRenderer) {
+    renderer = targetRenderer;
+
+    ttfInitialized = TTF_Init();
+    if (!ttfInitialized) {
+        std::cerr << "SDL_ttf could not initialize, using built-in font. SDL_ttf Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    if (!loadFontData()) {
+        std::cerr << "No system font found, using built-in font." << std::endl;
+        return;
+    }
+
+    largeFont = TTF_OpenFontIO(SDL_IOFromConstMem(fontData, fontDataSize), true, LARGE_POINT_SIZE);
+    if (!largeFont) {
+        std::cerr << "Failed to open font, using built-in font. SDL_ttf Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    // The small size shares the large font's data instead of opening the file again
+    smallFont = TTF_CopyFont(largeFont);
+    if (smallFont && !TTF_SetFontSize(smallFont, SMALL_POINT_SIZE)) {
+        TTF_CloseFont(smallFont);
+        smallFont = nullptr;
+    }
+}
+
+void TextRenderer::shutdown() {
+    for (int i = 0; i < CACHED_GLYPH_COUNT; i++) {
+        if (glyphTextures[i]) SDL_DestroyTexture(glyphTextures[i]);
+        glyphTextures[i] = nullptr;
+    }
+    glyphTexturesReady = false;
+    nextWarmGlyph = -1;
+
+    if (smallFont) TTF_CloseFont(smallFont);
+    if (largeFont) TTF_CloseFont(largeFont);
+    smallFont = largeFont = nullptr;
+
+    if (fontData) SDL_free(fontData);
+    fontData = nullptr;
+
+    if (ttfInitialized) TTF_Quit();
+    ttfInitialized = false;
+}
+
+void TextRenderer::startGlyphWarmup() {
+    if (!largeFont || nextWarmGlyph >= 0) return;
+    nextWarmGlyph = 0;
+}
+
+void TextRenderer::warmGlyphs() {
+    if (nextWarmGlyph >= 0 && nextWarmGlyph < CACHED_GLYPH_COUNT) {
+        warmNextGlyph();
+    }
+}
+
+void TextRenderer::warmNextGlyph() {
+    // One small glyph per frame keeps the cost of filling the cache out of any single frame
+    int i = nextWarmGlyph++;
+    Uint32 ch = static_cast<unsigned char>(CACHED_GLYPHS[i]);
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* surface = TTF_RenderGlyph_Solid(largeFont, ch, white);
+    if (surface) {
+        glyphTextures[i] = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_DestroySurface(surface);
+    }
+    int minX, maxX, minY, maxY;
+    if (!TTF_GetGlyphMetrics(largeFont, ch, &minX, &maxX, &minY, &maxY, &glyphAdvances[i])) {
+        // Without an advance the cached layout could not match a full render
+        SDL_DestroyTexture(glyphTextures[i]);
+        glyphTextures[i] = nullptr;
+    }
+
+    if (nextWarmGlyph == CACHED_GLYPH_COUNT) {
+        bool complete = true;
+        for (SDL_Texture* glyph : glyphTextures) {
+            complete = complete && glyph;
+        }
+        glyphTexturesReady = complete;
+    }
+}
+
+bool TextRenderer::drawFromGlyphCache(const std::string& text, int x, int y) {
+    for (char c : text) {
+        if (c == '\0' || !std::strchr(CACHED_GLYPHS, c)) return false;
+    }
+
+    // Same pen positions TTF_RenderText uses: each glyph's advance plus the pair kerning
+    int penX = x;
+    Uint32 previous = 0;
+    for (char c : text) {
+        Uint32 ch = static_cast<unsigned char>(c);
+        int kerning = 0;
+        if (previous && TTF_GetGlyphKerning(largeFont, previous, ch, &kerning)) {
+            penX += kerning;
+        }
+        int slot = static_cast<int>(std::strchr(CACHED_GLYPHS, c) - CACHED_GLYPHS);
+        SDL_Texture* glyph = glyphTextures[slot];
+        float w, h;
+        SDL_GetTextureSize(glyph, &w, &h);
+        SDL_FRect destRect = {static_cast<float>(penX), static_cast<float>(y), w, h};
+        SDL_RenderTexture(renderer, glyph, nullptr, &destRect);
+        penX += glyphAdvances[slot];
+        previous = ch;
+    }
+    return true;
+}
+
+void TextRenderer::drawFallback(const std::string& text, int x, int y, TextSize size) {
+    float scale = fallbackScale(size);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_SetRenderScale(renderer, scale, scale);
+    SDL_RenderDebugText(renderer, x / scale, y / scale, text.c_str());
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+}
+
+void TextRenderer::draw(const std::string& text, int x, int y, TextSize size) {
+    if (size == TextSize::LARGE && glyphTexturesReady && drawFromGlyphCache(text, x, y)) {
+        return;
+    }
+
+    TTF_Font* fontToUse = fontFor(size);
+    if (!fontToUse) fontToUse = largeFont;
+    if (!fontToUse) {
+        drawFallback(text, x, y, size);
+        return;
+    }
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* textSurface = TTF_RenderText_Solid(fontToUse, text.c_str(), text.length(), white);
+    if (textSurface) {
+        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
+        if (textTexture) {
+            SDL_FRect destRect = {static_cast<float>(x), static_cast<float>(y),
+                                 static_cast<float>(textSurface->w), static_cast<float>(textSurface->h)};
+            SDL_RenderTexture(renderer, textTexture, nullptr, &destRect);
+            SDL_DestroyTexture(textTexture);
+        }
+        SDL_DestroySurface(textSurface);
+    }
+}
+
+void TextRenderer::drawCentered(const std::string& text, int y, int areaWidth, TextSize size) {
+    // Cached and uncached text share one layout, so the font measures both and centered
+    // text stays put when the cache fills in
+    int textWidth;
+    TTF_Font* fontToUse = fontFor(size);
+    if (!fontToUse) fontToUse = largeFont;
+    if (fontToUse) {
+        int textHeight;
+        if (!TTF_GetStringSize(fontToUse, text.c_str(), text.length(), &textWidth, &textHeight)) return;
+    } else {
+        textWidth = static_cast<int>(text.length() * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * fallbackScale(size));
+    }
+
+    draw(text, (areaWidth - textWidth) / 2, y, size);
+}
@@ -1,8 +1,161 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
 #include "Game.h"
+#include "RoomHost.h"
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --seed <n>               Seed the match for reproducible play (default: random)\n"
+              << "  --vsync                  Sync presents to the display refresh instead of timed sleeping\n"
+              << "  --mute                   Run without sound\n"
+              << "  --offscreen              Render without a window using the software renderer\n"
+              << "  --quality <level>        Render detail: auto (default) adapts to frame time, 0 (full) to 4 holds a level\n"
+              << "  --full-redraw            Repaint the whole window every frame on the software renderer\n"
+              << "  --capture <path>         Record frames (.y4m video, .png sequence, anything else raw RGBA)\n"
+              << "  --capture-format <fmt>   Override the capture format: y4m, raw or png\n"
+              << "  --capture-frames <n>     Quit after capturing n frames\n"
+              << "  --telemetry <path>       Write a binary log of match events (decode with telemetry_decode)\n"
+              << "  --metrics-port <port>    Serve Prometheus metrics on 127.0.0.1:<port>\n"
+              << "  --arena <w>x<h>          Play in an arena larger than the window; the view follows the balls\n"
+              << "  --balls <n>              Serve n balls each round (default: 1)\n"
+              << "  --no-gravity             Turn off the gravity well\n"
+              << "  --ball-collisions        Let balls bounce off each other\n"
+              << "  --walls <mode>           Top/bottom wall behavior: bounce (default) or wrap\n"
+              << "  --no-rewind              Leave the REWIND power-up out (and skip keeping its history)\n"
+              << "  --fixed-point            Bit-reproducible 16.16 ball physics; logs state hashes to telemetry\n"
+              << "  --no-event-flight        Integrate and test every ball on every tick\n"
+              << "  --server <rooms>         Run this many bot matches headless and report tick lateness\n"
+              << "  --threads <n>            Worker threads for --server (default: one per core)\n"
+              << "  --duration <seconds>     How long --server runs (default: 10)\n"
+              << "  --help                   Show this message" << std::endl;
+}
 
 int main(int argc, char* argv[]) {
-    Game game;
+    GameOptions options;
+    bool formatOverridden = false;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--vsync") {
+            options.vsync = true;
+        } else if (arg == "--mute") {
+            options.mute = true;
+        } else if (arg == "--offscreen") {
+            options.offscreen = true;
+        } else if (arg == "--quality" && hasValue) {
+            std::string level = argv[++i];
+            if (level == "auto") {
+                options.qualityLevel = -1;
+            } else if (level.size() == 1 && level[0] >= '0' && level[0] <= '4') {
+                options.qualityLevel = level[0] - '0';
+            } else {
+                std::cerr << "Unknown quality level: " << level << std::endl;
+                return 1;
+            }
+        } else if (arg == "--full-redraw") {
+            options.dirtyRects = false;
+        } else if (arg == "--capture" && hasValue) {
+            options.capturePath = argv[++i];
+            if (!formatOverridden) {
+                options.captureFormat = FrameCapture::formatFromPath(options.capturePath);
+            }
+        } else if (arg == "--capture-format" && hasValue) {
+            std::string format = argv[++i];
+            if (format == "y4m") {
+                options.captureFormat = CaptureFormat::Y4M;
+            } else if (format == "png") {
+                options.captureFormat = CaptureFormat::PNG;
+            } else if (format == "raw") {
+                options.captureFormat = CaptureFormat::RAW;
+            } else {
+                std::cerr << "Unknown capture format: " << format << std::endl;
+                return 1;
+            }
+            formatOverridden = true;
+        } else if (arg == "--capture-frames" && hasValue) {
+            options.captureFrameLimit = std::atoi(argv[++i]);
+        } else if (arg == "--telemetry" && hasValue) {
+            options.telemetryPath = argv[++i];
+        } else if (arg == "--metrics-port" && hasValue) {
+            options.metricsPort = std::atoi(argv[++i]);
+        } else if (arg == "--arena" && hasValue) {
+            std::string size = argv[++i];
+            if (!options.rules.arena.parse(size)) {
+                std::cerr << "Invalid arena size: " << size << " (expected <width>x<height>, from "
+                          << Arena::MIN_WIDTH << "x" << Arena::MIN_HEIGHT << " to "
+                          << Arena::MAX_SIZE << "x" << Arena::MAX_SIZE << ")" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--balls" && hasValue) {
+            options.rules.ballCount = std::atoi(argv[++i]);
+            if (options.rules.ballCount < 1) {
+                std::cerr << "Invalid ball count: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--no-gravity") {
+            options.rules.gravity = false;
+        } else if (arg == "--ball-collisions") {
+            options.rules.ballCollisions = true;
+        } else if (arg == "--no-rewind") {
+            options.rules.rewind = false;
+        } else if (arg == "--fixed-point") {
+            options.rules.fixedPoint = true;
+        } else if (arg == "--no-event-flight") {
+            options.rules.eventFlight = false;
+        } else if (arg == "--walls" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "bounce") {
+                options.rules.wallMode = WallMode::BOUNCE;
+            } else if (mode == "wrap") {
+                options.rules.wallMode = WallMode::WRAP;
+            } else {
+                std::cerr << "Unknown wall mode: " << mode << std::endl;
+                return 1;
+            }
+        } else if (arg == "--server" && hasValue) {
+            options.serverRooms = std::atoi(argv[++i]);
+            if (options.serverRooms < 1) {
+                std::cerr << "Invalid room count: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--threads" && hasValue) {
+            options.serverThreads = std::atoi(argv[++i]);
+        } else if (arg == "--duration" && hasValue) {
+            options.serverDuration = std::atof(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    // Checked once every option is in, since --arena and --fixed-point come in either order
+    if (options.rules.fixedPoint && !options.rules.arena.fitsFixedPoint()) {
+        std::cerr << "Arena too large for --fixed-point: " << options.rules.arena.width << "x"
+                  << options.rules.arena.height << " (at most " << Arena::MAX_FIXED_POINT_SIZE
+                  << " on each side)" << std::endl;
+        return 1;
+    }
+    
+    if (options.serverRooms > 0) {
+        int threads = options.serverThreads > 0 ? options.serverThreads
+                                                : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        RoomHost host(options.rules, options.serverRooms, threads, options.seed != 0 ? options.seed : 1);
+        host.run(options.serverDuration);
+        host.printReport(std::cout);
+        return 0;
+    }
+    
+    Game game(options);
     
     if (!game.initialize()) {
         std::cerr << "Failed to initialize game!" << std::endl;
@@ -12,4 +165,4 @@ int main(int argc, char* argv[]) {
     game.run();
     
     return 0;
-} 
\ No newline at end of file
+}
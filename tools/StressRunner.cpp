@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Game.h"
+#include "RoomHost.h"
+#include "Scenario.h"
+
+// Runs scenario files (see Scenario.h) and prints how the cost of a tick grows with the
+// number of entities on the field. Headless runs time Match::tick alone, with bots on
+// the paddles and a breakdown by phase; --render runs the full game instead and splits
+// each frame into simulation and drawing. --integrator skips the scenarios and flies
+// balls through the gravity well at lower base tick rates instead.
+
+using Clock = std::chrono::steady_clock;
+
+struct StressOptions {
+    bool render = false;
+    bool offscreen = false;
+    bool integrator = false;
+    int qualityLevel = -1;
+    uint64_t seed = 1;
+};
+
+// Nearest-rank percentile of sorted samples, in milliseconds
+static double percentileMs(const std::vector<double>& sorted, double fraction) {
+    size_t rank = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[rank] * 1000.0;
+}
+
+static void printTimes(std::vector<double>& seconds, double entities) {
+    std::sort(seconds.begin(), seconds.end());
+    double total = 0.0;
+    for (double time : seconds) total += time;
+    double mean = total / seconds.size();
+    std::cout << std::setw(9) << static_cast<int>(entities + 0.5)
+              << std::setw(10) << static_cast<int>(seconds.size() / total)
+              << std::setw(9) << percentileMs(seconds, 0.5)
+              << std::setw(9) << percentileMs(seconds, 0.95)
+              << std::setw(9) << percentileMs(seconds, 0.99)
+              << std::setw(9) << seconds.back() * 1000.0
+              << std::setw(11) << mean * 1e6 / std::max(1.0, entities);
+}
+
+static void runHeadless(const Scenario& scenario, const StressOptions& options) {
+    std::cout << "  balls entities  ticks/s   p50 ms   p95 ms   p99 ms   max ms  us/entity  checks/tick"
+              << "  move% collide% power-ups% history%" << std::endl;
+
+    for (int ballCount : scenario.ballCounts) {
+        Match match(scenario.rules, options.seed);
+        Pcg32 placement(options.seed, Scenario::PLACEMENT_STREAM);
+        TickPhaseTimes phases;
+        match.setPhaseTimes(&phases);
+        scenario.populate(match, ballCount, placement);
+
+        std::vector<double> tickSeconds;
+        tickSeconds.reserve(scenario.ticks);
+        double entities = 0.0, checks = 0.0;
+        for (int tick = 0; tick < scenario.ticks; tick++) {
+            // Bots and refilling stay out of the timing; only the simulation is measured
+            PaddleInput left = RoomHost::botInput(match, match.getLeftPaddle(), true);
+            PaddleInput right = RoomHost::botInput(match, match.getRightPaddle(), false);
+            entities += match.getBalls().size() + match.getPowerUps().size();
+
+            Clock::time_point start = Clock::now();
+            match.tick(left, right);
+            tickSeconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+
+            checks += match.getCollisionChecks();
+            scenario.populate(match, ballCount, placement);
+        }
+
+        double phaseTotal = std::max(1e-12, phases.movement + phases.collisions + phases.powerUps + phases.history);
+        std::cout << std::fixed << std::setprecision(3) << std::setw(7) << ballCount;
+        printTimes(tickSeconds, entities / scenario.ticks);
+        std::cout << std::setprecision(0) << std::setw(13) << checks / scenario.ticks
+                  << std::setprecision(1) << std::setw(7) << phases.movement / phaseTotal * 100.0
+                  << std::setw(9) << phases.collisions / phaseTotal * 100.0
+                  << std::setw(11) << phases.powerUps / phaseTotal * 100.0
+                  << std::setw(9) << phases.history / phaseTotal * 100.0 << std::endl;
+    }
+}
+
+static bool runRendered(const Scenario& scenario, const StressOptions& options) {
+    std::cout << "  balls entities frames/s   p50 ms   p95 ms   p99 ms   max ms  us/entity  simulate ms  render ms"
+              << std::endl;
+
+    for (int ballCount : scenario.ballCounts) {
+        GameOptions gameOptions;
+        gameOptions.rules = scenario.rules;
+        gameOptions.seed = options.seed;
+        gameOptions.mute = true;
+        gameOptions.offscreen = options.offscreen;
+        gameOptions.qualityLevel = options.qualityLevel;
+        gameOptions.scenario = &scenario;
+        gameOptions.scenarioBalls = ballCount;
+
+        // Frames are paced to the display rate; the report counts only the work in each one
+        std::vector<StressFrame> frames;
+        {
+            Game game(gameOptions);
+            if (!game.initialize()) {
+                std::cerr << "Failed to initialize game!" << std::endl;
+                return false;
+            }
+            game.run();
+            frames = game.getStressFrames();
+        }
+        if (frames.empty()) {
+            std::cout << std::setw(7) << ballCount << "  (window closed)" << std::endl;
+            continue;
+        }
+
+        std::vector<double> frameSeconds;
+        double entities = 0.0, simulate = 0.0, render = 0.0;
+        for (const StressFrame& frame : frames) {
+            frameSeconds.push_back(frame.simulate + frame.render);
+            entities += frame.entities;
+            simulate += frame.simulate;
+            render += frame.render;
+        }
+
+        std::cout << std::fixed << std::setprecision(3) << std::setw(7) << ballCount;
+        printTimes(frameSeconds, entities / frames.size());
+        std::cout << std::setw(13) << simulate * 1000.0 / frames.size()
+                  << std::setw(11) << render * 1000.0 / frames.size() << std::endl;
+    }
+    return true;
+}
+
+// Matches always tick at the 60 Hz reference rate, so this is what exercises Ball::move
+// with longer steps: the same balls fly four reference seconds through the well at each
+// base rate, and their end positions are compared with a run at four times the reference rate
+static void runIntegrator(const StressOptions& options) {
+    static constexpr int BALL_COUNT = 1000;
+    static constexpr int REFERENCE_TICKS = 4 * Constants::FPS;
+    static constexpr double STEP_TICKS[] = {0.25, 1.0, 2.0, 3.0, 4.0};
+
+    Arena arena;
+    Pcg32 placement(options.seed, Scenario::PLACEMENT_STREAM);
+    std::vector<Ball> start;
+    start.reserve(BALL_COUNT);
+    for (int i = 0; i < BALL_COUNT; i++) {
+        // Off-center passes at ordinary serve speeds, all of them inside the well's reach
+        double angle = placement.nextDouble() * 2.0 * M_PI;
+        double radius = 60.0 + placement.nextDouble() * (Constants::GRAVITY_RADIUS - 60.0);
+        Ball ball(static_cast<int>(arena.centerX() + std::cos(angle) * radius),
+                  static_cast<int>(arena.centerY() + std::sin(angle) * radius), Constants::BALL_SIZE);
+        double heading = angle + M_PI * (0.75 + placement.nextDouble() * 0.5);
+        double speed = 3.0 + placement.nextDouble() * 5.0;
+        ball.velocity = Vector2(std::cos(heading) * speed, std::sin(heading) * speed);
+        start.push_back(ball);
+    }
+
+    std::cout << "  base Hz  step ticks  steps  total ms  p50 drift px  p95 drift px  max drift px" << std::endl;
+    std::vector<Ball> reference;
+    for (double stepTicks : STEP_TICKS) {
+        std::vector<Ball> balls = start;
+        int steps = static_cast<int>(REFERENCE_TICKS / stepTicks + 0.5);
+        Clock::time_point begin = Clock::now();
+        for (int step = 0; step < steps; step++) {
+            for (Ball& ball : balls) ball.move(arena, stepTicks);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        if (reference.empty()) reference = balls;
+
+        // Passes that graze the center scatter chaotically, so the tail says more than the mean
+        std::vector<double> drift;
+        for (int i = 0; i < BALL_COUNT; i++) {
+            drift.push_back((balls[i].position - reference[i].position).magnitude());
+        }
+        std::sort(drift.begin(), drift.end());
+        std::cout << std::fixed << std::setprecision(1) << std::setw(9) << Constants::FPS / stepTicks
+                  << std::setprecision(2) << std::setw(12) << stepTicks
+                  << std::setw(7) << steps
+                  << std::setprecision(3) << std::setw(10) << seconds * 1000.0
+                  << std::setw(13) << drift[BALL_COUNT / 2]
+                  << std::setw(13) << drift[BALL_COUNT * 95 / 100]
+                  << std::setw(13) << drift.back() << std::endl;
+    }
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] <scenario>...\n"
+              << "       " << program << " [--seed <n>] --integrator\n"
+              << "  --render            Run the full game in a window instead of the bare simulation\n"
+              << "  --offscreen         With --render, draw with the software renderer and no window\n"
+              << "  --quality <level>   With --render: auto (default) or hold level 0 (full) to 4\n"
+              << "  --seed <n>          Seed for the matches and ball placement (default: 1)\n"
+              << "  --integrator        Compare ball flight through the well at lower base tick rates\n"
+              << "  --help              Show this message" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    StressOptions options;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--render") {
+            options.render = true;
+        } else if (arg == "--offscreen") {
+            options.offscreen = true;
+        } else if (arg == "--quality" && hasValue) {
+            std::string level = argv[++i];
+            if (level == "auto") {
+                options.qualityLevel = -1;
+            } else if (level.size() == 1 && level[0] >= '0' && level[0] <= '4') {
+                options.qualityLevel = level[0] - '0';
+            } else {
+                std::cerr << "Unknown quality level: " << level << std::endl;
+                return 1;
+            }
+        } else if (arg == "--integrator") {
+            options.integrator = true;
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (options.integrator) {
+        runIntegrator(options);
+        return 0;
+    }
+    if (paths.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (const std::string& path : paths) {
+        Scenario scenario;
+        if (!Scenario::load(path, scenario)) {
+            return 1;
+        }
+        std::cout << scenario.name << ": " << scenario.ticks << " ticks per step, "
+                  << (options.render ? "rendered" : "headless") << std::endl;
+        if (options.render) {
+            if (!runRendered(scenario, options)) return 1;
+        } else {
+            runHeadless(scenario, options);
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
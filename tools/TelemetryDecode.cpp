@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "Telemetry.h"
+
+// Prints a telemetry log written by CppPong --telemetry as one event per line,
+// followed by per-type totals. Pass --summary to print only the totals.
+
+static const char* eventTypeName(uint8_t type) {
+    switch (static_cast<TelemetryEventType>(type)) {
+        case TelemetryEventType::MATCH_START: return "match_start";
+        case TelemetryEventType::MATCH_END: return "match_end";
+        case TelemetryEventType::PADDLE_HIT: return "paddle_hit";
+        case TelemetryEventType::WALL_BOUNCE: return "wall_bounce";
+        case TelemetryEventType::POWERUP_SPAWN: return "powerup_spawn";
+        case TelemetryEventType::POWERUP_PICKUP: return "powerup_pickup";
+        case TelemetryEventType::INVERSION_START: return "inversion_start";
+        case TelemetryEventType::INVERSION_END: return "inversion_end";
+        case TelemetryEventType::SCORE: return "score";
+        case TelemetryEventType::BALL_COLLISION: return "ball_collision";
+        case TelemetryEventType::STATE_HASH: return "state_hash";
+        case TelemetryEventType::REWIND: return "rewind";
+    }
+    return "unknown";
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    bool summaryOnly = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--summary") == 0) {
+            summaryOnly = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        std::cerr << "Usage: " << argv[0] << " [--summary] <telemetry.bin>" << std::endl;
+        return 1;
+    }
+
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        std::cerr << "Could not open " << path << std::endl;
+        return 1;
+    }
+
+    TelemetryFileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, "PONGTEL", 8) != 0) {
+        std::cerr << path << " is not a telemetry log" << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+    if (header.version != Telemetry::FORMAT_VERSION || header.eventSize != sizeof(TelemetryEvent)) {
+        std::cerr << "Unsupported telemetry version " << header.version
+                  << " (event size " << header.eventSize << ")" << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+
+    uint64_t counts[256] = {};
+    uint64_t total = 0;
+    TelemetryEvent event;
+    if (!summaryOnly) {
+        std::printf("%-10s %-16s %-6s %-6s %9s %9s %9s %9s\n", "tick", "event", "player", "detail", "x", "y", "a", "b");
+    }
+    while (std::fread(&event, sizeof(event), 1, file) == 1) {
+        counts[event.type]++;
+        total++;
+        if (summaryOnly) continue;
+        if (event.type == static_cast<uint8_t>(TelemetryEventType::STATE_HASH)) {
+            uint32_t low, high;
+            std::memcpy(&low, &event.x, sizeof(low));
+            std::memcpy(&high, &event.y, sizeof(high));
+            std::printf("%-10u %-16s %08x%08x\n", event.tick, eventTypeName(event.type), high, low);
+        } else {
+            std::printf("%-10u %-16s %-6u %-6u %9.2f %9.2f %9.3f %9.3f\n", event.tick, eventTypeName(event.type),
+                        event.player, event.detail, event.x, event.y, event.a, event.b);
+        }
+    }
+    std::fclose(file);
+
+    std::printf("\n%llu events\n", static_cast<unsigned long long>(total));
+    for (int type = 0; type < 256; type++) {
+        if (counts[type] > 0) {
+            std::printf("  %-16s %llu\n", eventTypeName(static_cast<uint8_t>(type)),
+                        static_cast<unsigned long long>(counts[type]));
+        }
+    }
+    return 0;
+}